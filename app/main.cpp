@@ -1,5 +1,14 @@
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "benchmark/hit_set_benchmark.h"
+#include "benchmark/strategy_benchmark.h"
 #include "game.h"
+#include "simulation.h"
 #ifdef __linux__
 #include <perfcpp/event_counter.h>
 #endif
@@ -12,8 +21,124 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
+#include <thread>
 #include <unistd.h>
-int main() {
+
+// the whole argument has to be a number of T at least `min`, a typo is reported instead of throwing out of main
+template<typename T>
+static bool parse_number(const char *text, T &value, T min = std::numeric_limits<T>::min()) {
+    char *end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || !std::in_range<T>(parsed) || static_cast<T>(parsed) < min)
+        return false;
+    value = static_cast<T>(parsed);
+    return true;
+}
+
+static int print_usage(const std::string &flag, const char *value) {
+    std::cerr << "invalid value for " << flag << ": " << value << "\n"
+              << "usage:\n"
+              << "  game [--seed n] [--record path] [--replay path] [--snapshot path] [--save-snapshot path]\n"
+              << "       [--waves size] [--wave-budget n] [--threaded] [--cell-stats]\n"
+              << "  game --benchmark [--baseline path] [--output path] [--strategy 0-" << physics::COUNT - 1
+              << "] [--warmup ticks] [--ticks n]\n"
+              << "       [--seed n] [--replay path] [--snapshot path] [--no-separation] [--headless] [--threads n]"
+                 " [--reps n]\n"
+              << "  game --benchmark-hit-sets [projectiles]\n";
+    return 1;
+}
+
+static int run_benchmark_sweep(int argc, char **argv, const std::string *titles, int screenWidth, int screenHeight) {
+    benchmark::BenchmarkConfig config;
+    int only_strategy = -1;
+    std::string replay_path;
+    std::string snapshot_path;
+    // --headless runs every strategy x rep in its own world without a window, --threads of them at a time
+    bool headless = false;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    int reps = 1;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--baseline" && has_value) {
+            config.baseline_path = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            config.output_path = argv[++i];
+        } else if (arg == "--strategy" && has_value) {
+            if (!parse_number(argv[++i], only_strategy, 0) || only_strategy >= physics::COUNT)
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--warmup" && has_value) {
+            if (!parse_number(argv[++i], config.warmup_ticks, 0))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--ticks" && has_value) {
+            if (!parse_number(argv[++i], config.measured_ticks, 1))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--seed" && has_value) {
+            if (!parse_number(argv[++i], config.seed))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--replay" && has_value) {
+            replay_path = argv[++i];
+        } else if (arg == "--snapshot" && has_value) {
+            snapshot_path = argv[++i];
+        } else if (arg == "--no-separation") {
+            config.separation = false;
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--threads" && has_value) {
+            if (!parse_number(argv[++i], threads, 1))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--reps" && has_value) {
+            if (!parse_number(argv[++i], reps, 1))
+                return print_usage(arg, argv[i]);
+        }
+    }
+
+    std::vector<benchmark::LevelResult> results;
+    if (headless) {
+        std::vector<simulation::HeadlessRun> runs;
+        for (int strategy = 0; strategy < physics::COUNT; strategy++) {
+            if (only_strategy >= 0 && strategy != only_strategy)
+                continue;
+            for (int rep = 0; rep < reps; rep++) {
+                std::string name = reps > 1 ? titles[strategy] + "-" + std::to_string(rep) : titles[strategy];
+                runs.push_back({name, static_cast<physics::PHYSICS_COLLISION_STRATEGY>(strategy),
+                                static_cast<uint32_t>(config.seed + rep)});
+            }
+        }
+        results = simulation::run_headless(runs, config, screenWidth, screenHeight, threads);
+    }
+
+    for (int strategy = 0; strategy < physics::COUNT && !headless; strategy++) {
+        if (only_strategy >= 0 && strategy != only_strategy)
+            continue;
+
+        Game game = Game(titles[strategy].c_str(), screenWidth, screenHeight, 0);
+        game.set_seed(config.seed);
+        if (!replay_path.empty())
+            game.replay_input(replay_path);
+        if (!snapshot_path.empty())
+            game.load_snapshot(snapshot_path);
+        game.init();
+        game.set_collision_strategy(static_cast<physics::PHYSICS_COLLISION_STRATEGY>(strategy));
+        auto strategy_results = game.run_benchmark(config);
+        results.insert(results.end(), strategy_results.begin(), strategy_results.end());
+    }
+
+    benchmark::print_results(results);
+    benchmark::save_results(config.output_path, results);
+
+    if (config.baseline_path.empty())
+        return 0;
+
+    auto regressions =
+            benchmark::find_regressions(benchmark::load_results(config.baseline_path), results,
+                                        config.regression_tolerance);
+    benchmark::print_regressions(regressions);
+    return regressions.empty() ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
 
 
 #ifdef EMSCRIPTEN
@@ -32,6 +157,58 @@ int main() {
             "collision-relationship", "collision-relationship-dontfragment", "collision-entity", "record-list",
             "spatial-hash-per-cell", "spatial-hash-per-entity" ,         "spatial-hash-relationship",
     };
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        return run_benchmark_sweep(argc, argv, titles, screenWidth, screenHeight);
+    }
+    // --benchmark-hit-sets [projectiles] compares the projectile hit bookkeeping without starting a game
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-hit-sets") {
+        int projectiles = 10000;
+        if (argc > 2 && !parse_number(argv[2], projectiles, 1))
+            return print_usage(argv[1], argv[2]);
+        benchmark::print_hit_set_results(benchmark::run_hit_set_benchmark(projectiles, 600, 1), projectiles);
+        return 0;
+    }
+
+    // --seed fixes the spawn pattern, --record captures the player input and --replay feeds it back,
+    // --snapshot starts from a saved world and --save-snapshot writes one when a run ends,
+    // --waves spawns that many enemies every 5 seconds, --wave-budget of them per tick,
+    // --threaded steps the simulation on its own thread, --cell-stats dumps the spatial hash cells of every tick
+    int seed = -1;
+    std::string record_path;
+    std::string replay_path;
+    std::string snapshot_path;
+    std::string save_snapshot_path;
+    int wave_size = 0;
+    int wave_budget = 100;
+    bool threaded = false;
+    bool cell_stats = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--seed" && has_value) {
+            if (!parse_number(argv[++i], seed, 0))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--record" && has_value) {
+            record_path = argv[++i];
+        } else if (arg == "--replay" && has_value) {
+            replay_path = argv[++i];
+        } else if (arg == "--snapshot" && has_value) {
+            snapshot_path = argv[++i];
+        } else if (arg == "--save-snapshot" && has_value) {
+            save_snapshot_path = argv[++i];
+        } else if (arg == "--waves" && has_value) {
+            if (!parse_number(argv[++i], wave_size, 0))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--wave-budget" && has_value) {
+            if (!parse_number(argv[++i], wave_budget, 1))
+                return print_usage(arg, argv[i]);
+        } else if (arg == "--threaded") {
+            threaded = true;
+        } else if (arg == "--cell-stats") {
+            cell_stats = true;
+        }
+    }
+
     for (int i = 0; i < 30; i++) {
         for (int strategy = 0; strategy < 7; strategy++) {
 
@@ -39,6 +216,20 @@ int main() {
                 continue;
 
             Game game = Game(titles[strategy].c_str(), screenWidth, screenHeight, i);
+            if (seed >= 0)
+                game.set_seed(seed + i);
+            if (!record_path.empty())
+                game.record_input(record_path + "-" + std::to_string(i));
+            if (!replay_path.empty())
+                game.replay_input(replay_path);
+            if (!snapshot_path.empty())
+                game.load_snapshot(snapshot_path);
+            if (!save_snapshot_path.empty())
+                game.save_snapshot(save_snapshot_path + "-" + std::to_string(i));
+            if (wave_size > 0)
+                game.spawn_waves(wave_size, 5.0f, wave_budget);
+            game.set_threaded(threaded);
+            game.record_cell_stats(cell_stats);
             game.init();
             game.set_collision_strategy(static_cast<physics::PHYSICS_COLLISION_STRATEGY>(strategy));
             game.run();
@@ -9,7 +9,7 @@ def join_all_results_in_one(dir, name):
     files = []
     for file in os.listdir(dir):
         if ".txt" in file:
-            files.append(pd.read_csv(dir + file, header=0 ,names=["Frame", "Entities", "FPS", "Frame Time (s)", "Physics Time (s)",  "Cache References", "Cache Misses", "Cache miss rate (%)"]))
+            files.append(pd.read_csv(dir + file, header=0 ,names=["Frame", "Entities", "FPS", "Frame Time (s)", "Physics Time (s)", "Cache References", "Cache Misses", "Cache miss rate (%)", "Destroyed", "Destruction Time (ms)", "Contacts per body"]))
     
     
     df = pd.concat(files, axis=0).groupby(["Frame"]).mean()
@@ -23,7 +23,7 @@ def save_to_csv_reduced(dir, name):
     files = []
     for file in os.listdir(dir):
         if ".txt" in file:
-            a = pd.read_csv(dir + file, header=0 ,names=["Frame", "Entities", "FPS", "Frame Time (s)", "Physics Time (s)", "Cache References", "Cache Misses", "Cache miss rate (%)"])
+            a = pd.read_csv(dir + file, header=0 ,names=["Frame", "Entities", "FPS", "Frame Time (s)", "Physics Time (s)", "Cache References", "Cache Misses", "Cache miss rate (%)", "Destroyed", "Destruction Time (ms)", "Contacts per body"])
             #print(a)
             #print(name)
             files.append(a)
@@ -0,0 +1,128 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "hit_set_benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <unordered_set>
+
+#include "modules/gameplay/hit_set.h"
+
+namespace benchmark {
+    static size_t allocations = 0;
+    static size_t allocated_bytes = 0;
+
+    // counts what either set asks the heap for, the HitSet spill included
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U> &) {}
+
+        T *allocate(size_t n) {
+            allocations++;
+            allocated_bytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, size_t n) {
+            allocated_bytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U> &) const { return true; }
+        template<typename U>
+        bool operator!=(const CountingAllocator<U> &) const { return false; }
+    };
+
+    using LegacyHitSet = std::unordered_set<int, std::hash<int>, std::equal_to<int>, CountingAllocator<int>>;
+    using CountedHitSet = gameplay::BasicHitSet<CountingAllocator<flecs::entity_t>>;
+
+    // most projectiles hit one or two enemies, a few pierce through a whole pack
+    static std::vector<std::vector<uint64_t>> generate_hits(int projectiles, std::mt19937 &rng) {
+        std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+        // real ids carry a generation in the upper bits, the old int key dropped it
+        std::uniform_int_distribution<uint64_t> id(1, 1ull << 40);
+        std::vector<std::vector<uint64_t>> hits(projectiles);
+        for (auto &projectile_hits: hits) {
+            float r = roll(rng);
+            int count = r < 0.7f ? 1 : r < 0.9f ? 3 : r < 0.99f ? 7 : 20;
+            for (int i = 0; i < count; i++) {
+                projectile_hits.push_back(id(rng));
+            }
+        }
+        return hits;
+    }
+
+    template<typename Set, typename Key>
+    static size_t run_frame(std::vector<Set> &sets, const Set &prefab_value,
+                            const std::vector<std::vector<uint64_t>> &hits, Key key) {
+        size_t new_hits = 0;
+        for (size_t p = 0; p < sets.size(); p++) {
+            // instancing a projectile copies the prefab value
+            sets[p] = prefab_value;
+            for (uint64_t id: hits[p]) {
+                // a target stays in contact for a few ticks after the first hit
+                for (int contact = 0; contact < 3; contact++) {
+                    if (sets[p].contains(key(id))) continue;
+                    sets[p].insert(key(id));
+                    new_hits++;
+                }
+            }
+        }
+        return new_hits;
+    }
+
+    template<typename Set, typename Key>
+    static HitSetResult measure(const std::string &name, int projectiles, int frames,
+                                const std::vector<std::vector<uint64_t>> &hits, uint32_t seed, Key key) {
+        const size_t heap_before = allocated_bytes;
+        std::vector<Set> sets(projectiles);
+        Set prefab_value{};
+        std::vector<double> samples;
+        samples.reserve(frames);
+        size_t checksum = 0;
+
+        allocations = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            checksum += run_frame(sets, prefab_value, hits, key);
+            auto end = std::chrono::high_resolution_clock::now();
+            samples.push_back(std::chrono::duration<double>(end - start).count());
+        }
+
+        // the allocator tracks every live block of the sets, they are all still alive here
+        size_t bytes = sets.size() * sizeof(Set) + (allocated_bytes - heap_before);
+        if (checksum == 0) printf("%s registered no hits\n", name.c_str());
+
+        double allocations_per_frame = frames > 0 ? static_cast<double>(allocations) / frames : 0.0;
+        return {name, summarize(samples, 2000, 0.95, seed), allocations_per_frame, bytes};
+    }
+
+    std::vector<HitSetResult> run_hit_set_benchmark(int projectiles, int frames, uint32_t seed) {
+        std::mt19937 rng(seed);
+        auto hits = generate_hits(projectiles, rng);
+
+        std::vector<HitSetResult> results;
+        results.push_back(measure<LegacyHitSet>("std::unordered_set<int>", projectiles, frames, hits, seed,
+                                                [](uint64_t id) { return static_cast<int>(id); }));
+        results.push_back(measure<CountedHitSet>("gameplay::HitSet", projectiles, frames, hits, seed,
+                                                 [](uint64_t id) { return static_cast<flecs::entity_t>(id); }));
+        return results;
+    }
+
+    void print_hit_set_results(const std::vector<HitSetResult> &results, int projectiles) {
+        for (const auto &result: results) {
+            printf("%-24s %6d projectiles | frame median %.3f ms [%.3f, %.3f] p99 %.3f | %.2f allocations/frame | "
+                   "%.1f KiB live\n",
+                   result.name.c_str(), projectiles, result.time.median * 1000.0, result.time.median_ci_low * 1000.0,
+                   result.time.median_ci_high * 1000.0, result.time.p99 * 1000.0, result.allocations_per_frame,
+                   result.live_bytes / 1024.0);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef HIT_SET_BENCHMARK_H
+#define HIT_SET_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "statistics.h"
+
+namespace benchmark {
+
+    struct HitSetResult {
+        std::string name;
+        // seconds to run one frame of hits over every live projectile
+        Summary time;
+        // averaged over every frame, the first one included
+        double allocations_per_frame;
+        // component storage plus heap owned by the sets while every projectile is alive
+        size_t live_bytes;
+    };
+
+    /**
+     * Replays the hit bookkeeping of `projectiles` live pierce/chain projectiles for `frames` frames, once with the
+     * previous std::unordered_set<int> and once with gameplay::HitSet. Every frame the projectiles are re-instanced
+     * from an empty prefab value, hit a few targets and re-test the ones they are still touching.
+     */
+    std::vector<HitSetResult> run_hit_set_benchmark(int projectiles, int frames, uint32_t seed);
+
+    void print_hit_set_results(const std::vector<HitSetResult> &results, int projectiles);
+}
+
+#endif //HIT_SET_BENCHMARK_H
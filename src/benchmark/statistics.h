@@ -0,0 +1,83 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef BENCHMARK_STATISTICS_H
+#define BENCHMARK_STATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace benchmark {
+
+    struct Summary {
+        size_t samples;
+        double median;
+        double p95;
+        double p99;
+        double median_ci_low;
+        double median_ci_high;
+    };
+
+    /**
+     * Percentile of an already sorted sample, linearly interpolated between the closest ranks
+     * @param sorted samples in ascending order
+     * @param p percentile in [0, 1]
+     */
+    inline double percentile(const std::vector<double> &sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        double rank = p * (sorted.size() - 1);
+        size_t lower = static_cast<size_t>(std::floor(rank));
+        size_t upper = std::min(lower + 1, sorted.size() - 1);
+        double t = rank - lower;
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * t;
+    }
+
+    inline double median_in_place(std::vector<double> &values) {
+        size_t mid = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + mid, values.end());
+        double upper = values[mid];
+        if (values.size() % 2 == 1) return upper;
+        double lower = *std::max_element(values.begin(), values.begin() + mid);
+        return (lower + upper) / 2.0;
+    }
+
+    /**
+     * Summarize a set of samples with its tail percentiles and a percentile bootstrap confidence interval
+     * for the median. The bootstrap is seeded so two runs over the same samples report the same interval.
+     * @param samples raw measurements, one per measured tick
+     * @param resamples number of bootstrap resamples
+     * @param confidence width of the interval (0.95 for a 95% interval)
+     */
+    inline Summary summarize(std::vector<double> samples, int resamples, double confidence, uint32_t seed) {
+        Summary summary{samples.size(), 0, 0, 0, 0, 0};
+        if (samples.empty()) return summary;
+
+        std::sort(samples.begin(), samples.end());
+        summary.median = percentile(samples, 0.5);
+        summary.p95 = percentile(samples, 0.95);
+        summary.p99 = percentile(samples, 0.99);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+        std::vector<double> resample(samples.size());
+        std::vector<double> medians(resamples);
+        for (int r = 0; r < resamples; r++) {
+            for (double &value: resample) {
+                value = samples[pick(rng)];
+            }
+            medians[r] = median_in_place(resample);
+        }
+        std::sort(medians.begin(), medians.end());
+
+        double alpha = 1.0 - confidence;
+        summary.median_ci_low = percentile(medians, alpha / 2.0);
+        summary.median_ci_high = percentile(medians, 1.0 - alpha / 2.0);
+        return summary;
+    }
+}
+
+#endif //BENCHMARK_STATISTICS_H
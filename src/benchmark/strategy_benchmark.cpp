@@ -0,0 +1,124 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "strategy_benchmark.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace benchmark {
+    static const char *results_header = "strategy,entities,samples,physics median,physics p95,physics p99,"
+                                        "physics median ci low,physics median ci high,frame median,frame p95,"
+                                        "frame p99,frame median ci low,frame median ci high,contacts per body";
+
+    static void write_summary(std::ofstream &file, const Summary &summary) {
+        file << summary.median << "," << summary.p95 << "," << summary.p99 << "," << summary.median_ci_low << ","
+             << summary.median_ci_high;
+    }
+
+    static Summary read_summary(std::vector<std::string>::const_iterator it, size_t samples) {
+        Summary summary{samples};
+        summary.median = std::stod(*it++);
+        summary.p95 = std::stod(*it++);
+        summary.p99 = std::stod(*it++);
+        summary.median_ci_low = std::stod(*it++);
+        summary.median_ci_high = std::stod(*it);
+        return summary;
+    }
+
+    std::vector<LevelResult> load_results(const std::string &file_path) {
+        std::vector<LevelResult> results;
+        std::ifstream file(file_path);
+        if (!file.is_open()) {
+            printf("Failed to open file %s\n", file_path.c_str());
+            return results;
+        }
+
+        std::string line;
+        std::getline(file, line); // header
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+            std::vector<std::string> cells;
+            std::stringstream line_stream(line);
+            std::string cell;
+            while (std::getline(line_stream, cell, ',')) {
+                cells.push_back(cell);
+            }
+            if (cells.size() < 13) continue;
+
+            try {
+                size_t samples = std::stoul(cells[2]);
+                // files written before the contacts column was added still load
+                results.push_back({cells[0], std::stoi(cells[1]), read_summary(cells.begin() + 3, samples),
+                                   read_summary(cells.begin() + 8, samples),
+                                   cells.size() > 13 ? std::stod(cells[13]) : 0.0});
+            } catch (std::exception &e) {
+                std::cout << "skipping malformed benchmark row: " << line << std::endl;
+            }
+        }
+        return results;
+    }
+
+    void save_results(const std::string &file_path, const std::vector<LevelResult> &results) {
+        try {
+            if (std::ofstream file(file_path); file.is_open()) {
+                file << results_header << "\n";
+                for (const auto &result: results) {
+                    file << result.strategy << "," << result.entity_count << "," << result.physics.samples << ",";
+                    write_summary(file, result.physics);
+                    file << ",";
+                    write_summary(file, result.frame);
+                    file << "," << result.contacts_per_body << "\n";
+                }
+                file.close();
+            } else {
+                printf("Failed to open file %s\n", file_path.c_str());
+            }
+        } catch (std::exception &e) {
+            std::cout << "could not write benchmark results" << e.what() << std::endl;
+        }
+    }
+
+    std::vector<Regression> find_regressions(const std::vector<LevelResult> &baseline,
+                                             const std::vector<LevelResult> &current, double tolerance) {
+        std::vector<Regression> regressions;
+        for (const auto &result: current) {
+            for (const auto &base: baseline) {
+                if (base.strategy != result.strategy || base.entity_count != result.entity_count) continue;
+
+                bool disjoint = result.physics.median_ci_low > base.physics.median_ci_high;
+                bool slower = result.physics.median > base.physics.median * (1.0 + tolerance);
+                if (disjoint && slower) {
+                    regressions.push_back({result.strategy, result.entity_count, base.physics.median,
+                                           result.physics.median, base.physics.median_ci_high,
+                                           result.physics.median_ci_low});
+                }
+                break;
+            }
+        }
+        return regressions;
+    }
+
+    void print_results(const std::vector<LevelResult> &results) {
+        for (const auto &result: results) {
+            printf("%-36s %6d entities | physics median %.3f ms [%.3f, %.3f] p95 %.3f p99 %.3f | frame median %.3f ms "
+                   "| %.2f contacts/body\n",
+                   result.strategy.c_str(), result.entity_count, result.physics.median * 1000.0,
+                   result.physics.median_ci_low * 1000.0, result.physics.median_ci_high * 1000.0,
+                   result.physics.p95 * 1000.0, result.physics.p99 * 1000.0, result.frame.median * 1000.0,
+                   result.contacts_per_body);
+        }
+    }
+
+    void print_regressions(const std::vector<Regression> &regressions) {
+        for (const auto &regression: regressions) {
+            printf("REGRESSION %s at %d entities: physics median %.3f ms -> %.3f ms (baseline ci high %.3f, current "
+                   "ci low %.3f)\n",
+                   regression.strategy.c_str(), regression.entity_count, regression.baseline_median * 1000.0,
+                   regression.current_median * 1000.0, regression.baseline_ci_high * 1000.0,
+                   regression.current_ci_low * 1000.0);
+        }
+    }
+}
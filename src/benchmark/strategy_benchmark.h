@@ -0,0 +1,66 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef STRATEGY_BENCHMARK_H
+#define STRATEGY_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "statistics.h"
+
+namespace benchmark {
+
+    struct BenchmarkConfig {
+        std::vector<int> entity_counts = {250, 500, 1000, 2000, 4000, 8000, 16000, 32000};
+        int warmup_ticks = 120;
+        int measured_ticks = 600;
+        int bootstrap_resamples = 2000;
+        double confidence = 0.95;
+        // a strategy stops climbing the sweep once its median frame takes longer than this
+        double max_frame_time = 0.5;
+        // relative slowdown of the median that has to be exceeded on top of the disjoint intervals
+        double regression_tolerance = 0.05;
+        unsigned int seed = 1;
+        // crowd separation steering, off to measure the contacts per body without it
+        bool separation = true;
+        std::string baseline_path;
+        std::string output_path = "benchmark-results.csv";
+    };
+
+    struct LevelResult {
+        std::string strategy;
+        int entity_count;
+        Summary physics;
+        Summary frame;
+        // mean overlapping neighbours of a separating body over the measured ticks
+        double contacts_per_body;
+    };
+
+    struct Regression {
+        std::string strategy;
+        int entity_count;
+        double baseline_median;
+        double current_median;
+        double baseline_ci_high;
+        double current_ci_low;
+    };
+
+    std::vector<LevelResult> load_results(const std::string &file_path);
+
+    void save_results(const std::string &file_path, const std::vector<LevelResult> &results);
+
+    /**
+     * A level is reported as a regression when the bootstrap intervals of the physics median do not overlap
+     * (the current lower bound is above the baseline upper bound) and the median grew by more than the tolerance.
+     */
+    std::vector<Regression> find_regressions(const std::vector<LevelResult> &baseline,
+                                             const std::vector<LevelResult> &current, double tolerance);
+
+    void print_results(const std::vector<LevelResult> &results);
+
+    void print_regressions(const std::vector<Regression> &regressions);
+}
+
+#endif //STRATEGY_BENCHMARK_H
@@ -15,8 +15,11 @@
 #include <emscripten/emscripten.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 #include "modules/ai/ai_module.h"
@@ -26,12 +29,14 @@
 #include "modules/engine/core/core_module.h"
 #include "modules/engine/input/components.h"
 #include "modules/engine/input/input_module.h"
+#include "modules/engine/input/input_recording.h"
 #include "modules/engine/physics/components.h"
 #include "modules/engine/physics/physics_module.h"
 #include "modules/player/player_module.h"
 #include "raylib.h"
 
 #include "modules/engine/rendering/components.h"
+#include "modules/engine/rendering/render_snapshot.h"
 #include "modules/engine/rendering/rendering_module.h"
 #include "modules/gameplay/components.h"
 #include "modules/gameplay/gameplay_module.h"
@@ -46,9 +51,11 @@
 #include "modules/engine/rendering/gui/prefabs.h"
 #include "modules/tilemap/components.h"
 #include "modules/tilemap/tilemap_module.h"
+#include "simulation.h"
+#include "world_snapshot.h"
 
 Game::Game(const char *windowName, int windowWidth, int windowHeight, int rep) :
-    m_windowName(windowName), m_windowHeight(windowHeight), m_windowWidth(windowWidth), rep(rep) {}
+    m_windowName(windowName), m_windowHeight(windowHeight), m_windowWidth(windowWidth), rep(rep), m_seed(rep) {}
 
 
 void Game::init() {
@@ -70,88 +77,32 @@ void Game::init() {
     m_world.set<flecs::Rest>({});
     // m_world.set_threads(static_cast<int>(std::thread::hardware_concurrency()));
 #endif
-    physics::PhysicsModule::reset_systems_list();
-    modules.push_back(m_world.import <core::CoreModule>());
-    modules.push_back(m_world.import <input::InputModule>());
-    modules.push_back(m_world.import <rendering::RenderingModule>());
-    modules.push_back(m_world.import <physics::PhysicsModule>());
-    modules.push_back(m_world.import <player::PlayerModule>());
-    modules.push_back(m_world.import <ai::AIModule>());
-    modules.push_back(m_world.import <gameplay::GameplayModule>());
-    modules.push_back(m_world.import <debug::DebugModule>());
-    modules.push_back(m_world.import <tilemap::TilemapModule>());
-
-
-    m_world.set<core::GameSettings>({m_windowName, m_windowWidth, m_windowHeight, m_windowWidth, m_windowHeight});
-    m_world.add<physics::CollisionRecordList>();
-    m_world.set<physics::SpatialHashingGrid>({32, {0, 0}});
-    m_world.set<core::Paused>({false});
-    m_world.set<core::EnabledMenus>({0});
-    flecs::entity player = m_world.entity("player")
-                                   .set<core::Tag>({"player"})
-                                   .set<core::Position2D>({2300.0f, 1300.0f})
-                                   .set<core::Speed>({300})
-                                   .set<physics::Velocity2D>({0, 0})
-                                   .set<physics::DesiredVelocity2D>({0, 0})
-                                   .set<physics::AccelerationSpeed>({15.0})
-                                   .set<physics::Collider>({
-                                           false,
-                                           true,
-                                           {-16, -16, 32, 32},
-                                           physics::CollisionFilter::player,
-                                           physics::player_filter,
-                                           physics::ColliderType::Circle,
-                                   })
-                                   .set<physics::CircleCollider>({16})
-                                   .set<rendering::Priority>({2})
-                                   .set<rendering::Renderable>({LoadTexture("../resources/player.png"), // 8x8
-                                                                {0, 0},
-                                                                2.f,
-                                                                WHITE})
-                                   .set<gameplay::Experience>({1, 0, 100000});
-
-
-    auto hori = m_world.entity("player_horizontal_input").child_of(player).set<input::InputHorizontal>({});
-    m_world.entity().child_of(hori).set<input::KeyBinding>({KEY_A, -1});
-    m_world.entity().child_of(hori).set<input::KeyBinding>({KEY_D, 1});
-    m_world.entity().child_of(hori).set<input::KeyBinding>({KEY_LEFT, -1});
-    m_world.entity().child_of(hori).set<input::KeyBinding>({KEY_RIGHT, 1});
-
-    auto vert = m_world.entity("player_vertical_input").child_of(player).set<input::InputVertical>({});
-    m_world.entity().child_of(vert).set<input::KeyBinding>({KEY_W, -1});
-    m_world.entity().child_of(vert).set<input::KeyBinding>({KEY_S, 1});
-    m_world.entity().child_of(vert).set<input::KeyBinding>({KEY_UP, -1});
-    m_world.entity().child_of(vert).set<input::KeyBinding>({KEY_DOWN, 1});
-
-    flecs::entity enemy = m_world.prefab("enemy")
-                                  .set<core::Tag>({"enemy"})
-                                  .set<core::Position2D>({800, 400})
-                                  .set<core::Speed>({25})
-                                  .set<gameplay::Health>({10, 10})
-                                  .set<gameplay::Damage>({1})
-                                  .set<gameplay::GiveExperience, gameplay::OnDeathEffect>({player, 2})
-                                  .add<ai::Target>(player)
-                                  .add<ai::FollowTarget>()
-                                  .set<ai::StoppingDistance>({16.0})
-                                  .set<physics::Velocity2D>({0, 0})
-                                  .set<physics::DesiredVelocity2D>({0, 0})
-                                  .set<physics::AccelerationSpeed>({5.0})
-                                  .set<physics::Collider>({true,
-                                                           false,
-                                                           {-16, -16, 32, 32},
-                                                           physics::CollisionFilter::enemy,
-                                                           physics::enemy_filter,
-                                                           physics::ColliderType::Circle})
-                                  .set<physics::CircleCollider>({16})
-                                  .set<rendering::Renderable>({LoadTexture("../resources/ghost.png"), // 8x8
-                                                               {0, 0},
-                                                               2.f,
-                                                               WHITE})
-                                  .set<rendering::Priority>({0});
-
-    auto spawner = m_world.entity("enemy_spawner").set<gameplay::Spawner>({enemy, 1});
-
-    m_world.set<rendering::TrackingCamera>({player, Camera2D{0}});
+    modules = simulation::import_modules(m_world, false);
+    simulation::create_entities(m_world, m_windowName, m_windowWidth, m_windowHeight, m_seed, false);
+    m_world.set<rendering::RenderSnapshots>({&m_snapshots});
+
+    if (m_waves.wave_size > 0) {
+        m_world.lookup("enemy_spawner").set<gameplay::WaveSpawner>(m_waves);
+    }
+    if (!m_record_path.empty()) {
+        m_world.set<input::InputRecording>({m_record_path, {}, {0, 0}});
+    }
+    if (!m_replay_path.empty()) {
+        input::InputPlayback playback{};
+        if (input::load_input_playback(m_replay_path, playback)) {
+            m_world.set<input::InputPlayback>(playback);
+        }
+    }
+    if (m_record_cell_stats) {
+        m_world.get_mut<physics::SpatialHashStats>().recording = true;
+    }
+    if (!m_load_snapshot_path.empty()) {
+        auto start = std::chrono::high_resolution_clock::now();
+        int restored = snapshot::load_world(m_world, m_load_snapshot_path);
+        auto end = std::chrono::high_resolution_clock::now();
+        TraceLog(LOG_INFO, "SNAPSHOT: restored %d entities in %.3fms", restored,
+                 std::chrono::duration<double, std::milli>(end - start).count());
+    }
 }
 
 void Game::run() {
@@ -163,6 +114,10 @@ void Game::run() {
 #if defined(EMSCRIPTEN)
     emscripten_set_main_loop_arg(m_world.progress(), this, 0, 1);
 #else
+    if (m_threaded) {
+        run_threaded();
+        return;
+    }
     std::vector<std::chrono::microseconds> delta_times;
     std::vector<int> frameRates;
     std::vector<int> entities;
@@ -203,6 +158,7 @@ void Game::run() {
             int fps = (1.f / average_frame);
 
             recorder.save_frame(m_world, (int) (1.f / average_frame));
+            recorder.save_spatial_hash_stats(m_world);
 
             if (fps  < frame_capture_count) { // greater than 33 ms
                 if (frames > 60) {
@@ -225,37 +181,184 @@ void Game::run() {
         std::stringstream filename_stream;
         filename_stream << m_windowName << "-" << rep << ".txt";
         recorder.dump_data(filepath_stream.str(), filename_stream.str());
+        std::stringstream cells_filename_stream;
+        cells_filename_stream << m_windowName << "-" << rep << "-cells.txt";
+        recorder.dump_spatial_hash_data(filepath_stream.str(), cells_filename_stream.str());
 
 
 #endif
 
 
+        shutdown();
+        frames = 0;
+    }
+}
+
+#endif
+
+    void Game::run_threaded() {
+        // startup already ran in run(). The world is never touched by both threads at once. The simulation holds the
+        // lock for a whole step and publishes its sprites to m_snapshots at the end of it. The main thread only
+        // takes it to sample the input, prepare the gui and pick the latest snapshot, then again to draw the gizmos
+        // and gui over it. The snapshot draw and the buffer swap happen outside the lock, so the overlay can be a
+        // step ahead of the sprites
+        flecs::entity simulation_pipeline = simulation::simulation_pipeline(m_world);
+        flecs::entity main_pipeline = simulation::main_thread_pipeline(m_world);
+        flecs::entity overlay_pipeline = simulation::overlay_pipeline(m_world);
+        std::mutex world_mutex;
+        std::atomic<bool> running = true;
+        using clock = std::chrono::steady_clock;
+        const auto tick_length = std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<float>(physics::PHYSICS_TICK_LENGTH));
+        const auto frame_length = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(1.0f / 300));
+        // the frames are paced below, EndDrawing would otherwise also wait for the target fps
+        SetTargetFPS(0);
+
+#ifdef __linux__
+        const auto counter_definition = perf::CounterDefinition{};
+        auto recorder = PerfRecorder{counter_definition};
+        recorder.init();
+        recorder.start_recording();
+#endif
+
+        std::thread simulation_thread([&]() {
+            auto next_tick = clock::now();
+            while (running) {
+                auto start = clock::now();
+                double physics_time;
+                {
+                    std::lock_guard lock(world_mutex);
+                    m_world.run_pipeline(simulation_pipeline, physics::PHYSICS_TICK_LENGTH);
+                    physics_time = physics::get_total_time(m_world);
+#ifdef __linux__
+                    recorder.save_spatial_hash_stats(m_world);
+#endif
+                }
+                auto end = clock::now();
+#ifdef __linux__
+                recorder.save_simulation_tick(std::chrono::duration<double>(end - start).count(), physics_time);
+#endif
+                // a late tick doesn't make the next ones run back to back
+                next_tick = std::max(next_tick + tick_length, end);
+                std::this_thread::sleep_until(next_tick);
+            }
+        });
+
+#ifdef __linux__
+        float average_frame = 1.0f / 300.0f;
+#endif
+        auto next_frame = clock::now();
+        while (true) {
+#ifdef __linux__
+            recorder.start_live_recording();
+#endif
+            const float dt = GetFrameTime();
+            {
+                std::lock_guard lock(world_mutex);
+                if (WindowShouldClose() || m_world.has<core::ExitConfirmed>()) break;
+                m_world.run_pipeline(main_pipeline, dt);
+            }
+            rendering::render_snapshot::draw(m_snapshots);
+            {
+                std::lock_guard lock(world_mutex);
+                m_world.run_pipeline(overlay_pipeline, dt);
+            }
+            EndDrawing();
+#ifdef __linux__
+            recorder.stop_live_recording();
+            average_frame += (recorder.get_dt() - average_frame) / 60.0f;
+            {
+                std::lock_guard lock(world_mutex);
+                recorder.save_frame(m_world, (int) (1.0f / average_frame));
+            }
+#endif
+            next_frame = std::max(next_frame + frame_length, clock::now());
+            std::this_thread::sleep_until(next_frame);
+        }
+        running = false;
+        simulation_thread.join();
+
+#ifdef __linux__
+        recorder.stop_recording();
+        recorder.close();
+        std::stringstream filepath_stream;
+        filepath_stream << "../../results/" << m_windowName << "/";
+        std::stringstream filename_stream;
+        filename_stream << m_windowName << "-" << rep << ".txt";
+        std::stringstream simulation_filename_stream;
+        simulation_filename_stream << m_windowName << "-" << rep << "-simulation.txt";
+        recorder.dump_data(filepath_stream.str(), filename_stream.str());
+        recorder.dump_simulation_data(filepath_stream.str(), simulation_filename_stream.str());
+        std::stringstream cells_filename_stream;
+        cells_filename_stream << m_windowName << "-" << rep << "-cells.txt";
+        recorder.dump_spatial_hash_data(filepath_stream.str(), cells_filename_stream.str());
+#endif
+
+        shutdown();
+    }
+
+    std::vector<benchmark::LevelResult> Game::run_benchmark(const benchmark::BenchmarkConfig &config) {
+        m_world.get_mut<core::Random>().engine.seed(config.seed + rep);
+        auto results = simulation::run_sweep(
+                m_world, m_windowName, config, [this]() { UpdateDrawFrameDesktop(); },
+                [this]() { return WindowShouldClose() || m_world.has<core::ExitConfirmed>(); });
+
+        shutdown();
+        return results;
+    }
+
+    void Game::shutdown() {
+        if (!m_save_snapshot_path.empty()) {
+            snapshot::save_world(m_world, m_save_snapshot_path);
+        }
+
         m_world.quit();
         m_world.progress();
 
+        if (const input::InputRecording *recording = m_world.try_get<input::InputRecording>()) {
+            input::save_input_recording(recording->file_path, *recording);
+        }
+
         // De-Initialization
         //--------------------------------------------------------------------------------------
         CloseWindow(); // Close window and OpenGL context
-        physics::PhysicsModule::reset_systems_list();
         //--------------------------------------------------------------------------------------
         for (auto module: modules) {
             module.destruct();
         }
-        // recorder.close();
         modules.clear();
         // std::cout << "inner reset: refcount = " << flecs_poly_refcount(m_world) << std::endl;
         m_world.reset();
-        frames = 0;
     }
-}
-
-#endif
 
     void Game::set_collision_strategy(physics::PHYSICS_COLLISION_STRATEGY strategy) {
-        physics::PhysicsModule::set_collision_strategy(strategy);
+        physics::PhysicsModule::set_collision_strategy(m_world, strategy);
     }
 
-    void Game::UpdateDrawFrameDesktop() { m_world.progress(GetFrameTime()); }
+    void Game::set_seed(uint32_t seed) { m_seed = seed; }
+
+    void Game::record_input(const std::string &file_path) { m_record_path = file_path; }
+
+    void Game::replay_input(const std::string &file_path) { m_replay_path = file_path; }
+
+    void Game::load_snapshot(const std::string &file_path) { m_load_snapshot_path = file_path; }
+
+    void Game::save_snapshot(const std::string &file_path) { m_save_snapshot_path = file_path; }
+
+    void Game::spawn_waves(int size, float interval, int budget) { m_waves = {size, interval, budget, 0.0f, 0}; }
+
+    void Game::set_threaded(bool threaded) { m_threaded = threaded; }
+
+    void Game::record_cell_stats(bool record) { m_record_cell_stats = record; }
+
+    void Game::UpdateDrawFrameDesktop() {
+        // recorded sessions are indexed per tick, a fixed step keeps them identical whatever the frame rate
+        if (m_world.has<input::InputRecording>() || m_world.has<input::InputPlayback>()) {
+            m_world.progress(physics::PHYSICS_TICK_LENGTH);
+            return;
+        }
+        m_world.progress(GetFrameTime());
+    }
 
     void Game::UpdateDrawFrameWeb(void *game) {
         Game *instance = static_cast<Game *>(game);
@@ -7,28 +7,57 @@
 
 #include <string>
 
+#include "benchmark/strategy_benchmark.h"
 #include "flecs.h"
 #include "modules/engine/physics/physics_module.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/gameplay/components.h"
 
 class Game {
 public:
     Game(const char* windowName, int windowWidth, int windowHeight, int rep);
     void run();
+    std::vector<benchmark::LevelResult> run_benchmark(const benchmark::BenchmarkConfig &config);
     void init();
     void set_collision_strategy(physics::PHYSICS_COLLISION_STRATEGY strategy);
+    // call before init, the seed defaults to the rep so repetitions stay distinct but reproducible
+    void set_seed(uint32_t seed);
+    void record_input(const std::string &file_path);
+    void replay_input(const std::string &file_path);
+    // restore the enemies of a snapshot at init instead of ramping up, and write one when the game shuts down
+    void load_snapshot(const std::string &file_path);
+    void save_snapshot(const std::string &file_path);
+    // spawn waves of `size` enemies every `interval` seconds, at most `budget` per tick, instead of one per frame
+    void spawn_waves(int size, float interval, int budget);
+    // step the simulation on its own thread at the physics tick while this one draws the published snapshots
+    void set_threaded(bool threaded);
+    // record the spatial hash cells every detection tick and dump them next to the frame data
+    void record_cell_stats(bool record);
 
 private:
 
     std::vector<flecs::entity> modules;
 
     void reset();
+    void shutdown();
     void UpdateDrawFrameDesktop();
+    void run_threaded();
     static void UpdateDrawFrameWeb(void *world);
     flecs::world m_world;
     std::string m_windowName;
     int m_windowHeight;
     int m_windowWidth;
     int rep;
+    uint32_t m_seed;
+    std::string m_record_path;
+    std::string m_replay_path;
+    std::string m_load_snapshot_path;
+    std::string m_save_snapshot_path;
+    gameplay::WaveSpawner m_waves{};
+    // outside the world so the main thread draws the last published step without locking it
+    rendering::RenderSnapshotBuffer m_snapshots;
+    bool m_threaded = false;
+    bool m_record_cell_stats = false;
 };
 
 
@@ -10,23 +10,38 @@
 #include "components.h"
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "systems/create_flow_field_system.h"
 #include "systems/follow_target_system.h"
 #include "systems/stop_when_arrived_at_target_system.h"
+#include "systems/update_flow_field_system.h"
 
 namespace ai {
     void AIModule::register_components(flecs::world world) {
         world.component<Target>();
         world.component<FollowTarget>();
         world.component<StoppingDistance>();
+        world.component<FlowFieldGoal>();
+        world.component<FlowField>().add(flecs::Singleton);
     }
 
     void AIModule::register_systems(flecs::world world) {
-        world.system<const core::Position2D, const core::Speed, physics::DesiredVelocity2D>("Follow Target")
+        world.observer<const physics::CollisionGrid>("Create flow field")
+                .event(flecs::OnSet)
+                .each(systems::create_flow_field_system);
+
+        world.system<const core::Position2D, FlowField>("Update flow field")
+                .with<FlowFieldGoal>()
+                .kind(flecs::PreUpdate)
+                .each(systems::update_flow_field_system);
+
+        world.system<const core::Position2D, const core::Speed, physics::DesiredVelocity2D, const FlowField *,
+                     const physics::SimulationLod *, const physics::SimulationLodSettings>("Follow Target")
                 .with<Target>(flecs::Wildcard)
                 .with<FollowTarget>()
                 .each(systems::follow_target_system);
 
-        world.system<const StoppingDistance, const core::Position2D, physics::DesiredVelocity2D>(
+        world.system<const StoppingDistance, const core::Position2D, physics::DesiredVelocity2D,
+                     const physics::SimulationLod *, const physics::SimulationLodSettings>(
                     "Stop when arrived at distance of target")
                 .with<Target>(flecs::Wildcard)
                 .each(systems::stop_when_arrived_at_target_system);
@@ -5,7 +5,13 @@
 #ifndef AI_COMPONENTS_H
 #define AI_COMPONENTS_H
 
+#include <cstdint>
+#include <future>
 #include <string>
+#include <vector>
+
+#include <flecs.h>
+#include <raylib.h>
 
 namespace ai {
 
@@ -16,6 +22,27 @@ namespace ai {
     struct StoppingDistance {
         float value;
     };
+
+    // the flow field leads to the entity with this tag
+    struct FlowFieldGoal {};
+
+    /**
+     * Direction towards the goal for every cell of the collision grid, one byte per cell so sampling it stays
+     * cheap for any number of enemies. It is rebuilt on a worker thread only when the goal changes cell.
+     */
+    struct FlowField {
+        int width;
+        int height;
+        float cell_size;
+        Vector2 origin;
+        std::vector<uint8_t> blocked;
+        // index into flow_field::DIRECTIONS, flow_field::NO_DIRECTION on walls, unreachable cells and the goal
+        std::vector<uint8_t> directions;
+        flecs::entity_t goal_entity;
+        int goal_cell;
+        std::shared_future<std::vector<uint8_t>> pending;
+        int pending_cell;
+    };
 }
 
 #endif //AI_COMPONENTS_H
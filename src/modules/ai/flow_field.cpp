@@ -0,0 +1,72 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "flow_field.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ai::flow_field {
+    static bool walkable(const std::vector<uint8_t> &blocked, int width, int height, int x, int y) {
+        return x >= 0 && y >= 0 && x < width && y < height && !blocked[y * width + x];
+    }
+
+    // a diagonal step is only allowed when both straight cells around it are open
+    static bool can_step(const std::vector<uint8_t> &blocked, int width, int height, int x, int y, int d) {
+        int nx = x + OFFSETS[d][0];
+        int ny = y + OFFSETS[d][1];
+        if (!walkable(blocked, width, height, nx, ny)) return false;
+        if (d < 4) return true;
+        return walkable(blocked, width, height, nx, y) && walkable(blocked, width, height, x, ny);
+    }
+
+    std::vector<uint8_t> build(const std::vector<uint8_t> &blocked, int width, int height, int goal) {
+        constexpr uint32_t UNREACHED = std::numeric_limits<uint32_t>::max();
+        const int cell_count = width * height;
+        std::vector<uint8_t> directions(cell_count, NO_DIRECTION);
+        if (goal < 0 || goal >= cell_count || blocked[goal]) return directions;
+
+        std::vector<uint32_t> distance(cell_count, UNREACHED);
+        std::vector<int> frontier;
+        frontier.reserve(cell_count);
+        frontier.push_back(goal);
+        distance[goal] = 0;
+        for (size_t head = 0; head < frontier.size(); head++) {
+            int cell = frontier[head];
+            int x = cell % width;
+            int y = cell / width;
+            for (int d = 0; d < 8; d++) {
+                if (!can_step(blocked, width, height, x, y, d)) continue;
+                int next = (y + OFFSETS[d][1]) * width + x + OFFSETS[d][0];
+                if (distance[next] != UNREACHED) continue;
+                distance[next] = distance[cell] + 1;
+                frontier.push_back(next);
+            }
+        }
+
+        for (int cell: frontier) {
+            if (cell == goal) continue;
+            int x = cell % width;
+            int y = cell / width;
+            uint32_t best = distance[cell];
+            for (int d = 0; d < 8; d++) {
+                if (!can_step(blocked, width, height, x, y, d)) continue;
+                int next = (y + OFFSETS[d][1]) * width + x + OFFSETS[d][0];
+                // straight neighbours come first so ties prefer them
+                if (distance[next] < best) {
+                    best = distance[next];
+                    directions[cell] = static_cast<uint8_t>(d);
+                }
+            }
+        }
+        return directions;
+    }
+
+    int cell_of(const FlowField &field, Vector2 position) {
+        int x = static_cast<int>(std::floor((position.x - field.origin.x) / field.cell_size + 0.5f));
+        int y = static_cast<int>(std::floor((position.y - field.origin.y) / field.cell_size + 0.5f));
+        if (x < 0 || y < 0 || x >= field.width || y >= field.height) return -1;
+        return y * field.width + x;
+    }
+}
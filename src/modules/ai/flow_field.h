@@ -0,0 +1,36 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace ai::flow_field {
+    constexpr uint8_t NO_DIRECTION = 255;
+
+    // the 8 neighbours, straight ones first
+    constexpr int OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    constexpr float DIAGONAL = 0.70710678f;
+    constexpr Vector2 DIRECTIONS[8] = {{1, 0},         {-1, 0},         {0, 1},          {0, -1},
+                                       {DIAGONAL, DIAGONAL},  {DIAGONAL, -DIAGONAL},
+                                       {-DIAGONAL, DIAGONAL}, {-DIAGONAL, -DIAGONAL}};
+
+    /**
+     * Breadth first integration from the goal over the walkable cells, then every cell points to its neighbour
+     * closest to the goal. Diagonals never cut a wall corner so bodies don't snag on them.
+     * @return one direction per cell, see FlowField::directions
+     */
+    std::vector<uint8_t> build(const std::vector<uint8_t> &blocked, int width, int height, int goal);
+
+    // cell containing the position, -1 outside of the grid
+    int cell_of(const FlowField &field, Vector2 position);
+}
+
+#endif //FLOW_FIELD_H
@@ -0,0 +1,20 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef CREATE_FLOW_FIELD_SYSTEM_H
+#define CREATE_FLOW_FIELD_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/ai/components.h"
+#include "modules/engine/physics/components.h"
+
+namespace ai::systems {
+    // a new collision grid invalidates the field, it is rebuilt the next time the goal is seen
+    inline void create_flow_field_system(flecs::iter &it, size_t, const physics::CollisionGrid &grid) {
+        it.world().set<FlowField>(
+                {grid.width, grid.height, grid.cell_size, grid.origin, grid.blocked, {}, 0, -1, {}, -1});
+    }
+}
+#endif //CREATE_FLOW_FIELD_SYSTEM_H
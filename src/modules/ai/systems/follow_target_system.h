@@ -9,16 +9,33 @@
 #include <raylib.h>
 #include <raymath.h>
 
+#include "modules/ai/components.h"
+#include "modules/ai/flow_field.h"
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/simulation_lod.h"
 
 namespace ai::systems {
     inline void follow_target_system(flecs::iter &it, size_t i,
                               const core::Position2D &position,
                               const core::Speed &speed,
-                              physics::DesiredVelocity2D &velocity) {
-        const flecs::entity target = it.pair(3).second(); // target component
+                              physics::DesiredVelocity2D &velocity,
+                              const FlowField *field,
+                              const physics::SimulationLod *lod,
+                              const physics::SimulationLodSettings &lod_settings) {
+        // off-screen enemies steer on their slice only and keep their velocity in between
+        if (!physics::lod::updates_this_tick(lod, lod_settings)) return;
+        const flecs::entity target = it.pair(6).second(); // target component
         if (target.id() == 0) return;
+
+        // around walls the field knows the way, the direct line is only used on the goal cell or off the map
+        if (field && field->goal_entity == target.id() && !field->directions.empty()) {
+            int cell = flow_field::cell_of(*field, position.value);
+            if (cell >= 0 && field->directions[cell] != flow_field::NO_DIRECTION) {
+                velocity.value = flow_field::DIRECTIONS[field->directions[cell]] * speed.value;
+                return;
+            }
+        }
         const Vector2 dir = Vector2Normalize(target.get<core::Position2D>().value - position.value);
         velocity.value = dir * speed.value;
     }
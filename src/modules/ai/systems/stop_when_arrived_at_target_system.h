@@ -12,13 +12,17 @@
 #include "modules/ai/components.h"
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/simulation_lod.h"
 
 namespace ai::systems {
     inline void stop_when_arrived_at_target_system(flecs::iter &it, size_t i,
                               const StoppingDistance &distance,
                               const core::Position2D &pos,
-                              physics::DesiredVelocity2D &velocity) {
-        const flecs::entity target = it.pair(3).second(); // target component
+                              physics::DesiredVelocity2D &velocity,
+                              const physics::SimulationLod *lod,
+                              const physics::SimulationLodSettings &lod_settings) {
+        if (!physics::lod::updates_this_tick(lod, lod_settings)) return;
+        const flecs::entity target = it.pair(5).second(); // target component
         if (target.id() == 0) return;
         const Vector2 ab = target.get<core::Position2D>().value - pos.value;
 
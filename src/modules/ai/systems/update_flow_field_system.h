@@ -0,0 +1,43 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef UPDATE_FLOW_FIELD_SYSTEM_H
+#define UPDATE_FLOW_FIELD_SYSTEM_H
+
+#include <chrono>
+#include <future>
+
+#include <flecs.h>
+
+#include "modules/ai/components.h"
+#include "modules/ai/flow_field.h"
+#include "modules/engine/core/components.h"
+#include "modules/engine/input/components.h"
+
+namespace ai::systems {
+    inline void update_flow_field_system(flecs::iter &it, size_t i, const core::Position2D &pos, FlowField &field) {
+        field.goal_entity = it.entity(i);
+
+        // recorded and replayed sessions must see the new field on the same tick, they wait for the worker
+        bool deterministic = it.world().has<input::InputRecording>() || it.world().has<input::InputPlayback>();
+        if (field.pending.valid() &&
+            (deterministic || field.pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+            field.directions = field.pending.get();
+            field.goal_cell = field.pending_cell;
+            field.pending = {};
+            field.pending_cell = -1;
+        }
+
+        int cell = flow_field::cell_of(field, pos.value);
+        if (cell < 0 || cell == field.goal_cell || field.pending.valid()) return;
+
+        // enemies keep following the previous field until this one lands
+        field.pending_cell = cell;
+        field.pending = std::async(std::launch::async, [blocked = field.blocked, width = field.width,
+                                                        height = field.height, cell]() {
+                            return flow_field::build(blocked, width, height, cell);
+                        }).share();
+    }
+}
+#endif //UPDATE_FLOW_FIELD_SYSTEM_H
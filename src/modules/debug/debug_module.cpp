@@ -23,6 +23,7 @@
 #include "systems/debug_fps_system.h"
 #include "systems/debug_grid_system.h"
 #include "systems/debug_mouse_position_system.h"
+#include "systems/debug_spatial_hash_heatmap_system.h"
 
 
 namespace debug {
@@ -76,9 +77,18 @@ namespace debug {
                 .each(systems::debug_grid_system);
         debug_grid.disable();
 
+        // both draw nothing until the stats are recorded, see the menu item
+        world.system<const physics::SpatialHashingGrid, const physics::SpatialHashStats>("Draw Spatial Hash Heatmap")
+                .kind<rendering::RenderGizmos>()
+                .each(systems::debug_spatial_hash_heatmap_system);
+        world.system<const physics::SpatialHashStats>("Draw Spatial Hash Stats")
+                .kind<rendering::RenderGUI>()
+                .each(systems::debug_spatial_hash_stats_system);
+
+        flecs::entity_t enemy_tag = core::tags::intern(world, "enemy");
         debug_closest_enemy = world.system("Draw Ray to closest target")
                 .kind<rendering::RenderGizmos>()
-                .run(systems::debug_closest_enemy_to_player_system);
+                .run([enemy_tag](flecs::iter &it) { systems::debug_closest_enemy_to_player_system(it, enemy_tag); });
         debug_closest_enemy.disable();
 
             grid_cell_grow = world.system<physics::SpatialHashingGrid>()
@@ -132,15 +142,11 @@ namespace debug {
                     "Toggle View Closest Enemy", debug_closest_enemy, rendering::gui::TOGGLE
                 });
 
-            world.entity("debug_collisions_item_7").child_of(dropdown)
-                .set<rendering::gui::MenuBarTabItem>({"Toggle Naive Collisions", physics::m_collision_detection_naive_system, rendering::gui::TOGGLE});
-            world.entity("debug_collisions_item_8").child_of(dropdown)
-                    .set<rendering::gui::MenuBarTabItem>({
-                        "Toggle Hashing Collisions", physics::m_collision_detection_spatial_hashing_system, rendering::gui::TOGGLE
-                    });
             world.entity("debug_collisions_item_9").child_of(dropdown)
                    .set<rendering::gui::MenuBarTabItem>({
-                       "Toggle Hashing Collisions ECS", physics::m_collision_detection_spatial_ecs, rendering::gui::TOGGLE
+                       "Toggle Hashing Collisions ECS",
+                       world.get<physics::CollisionStrategy>().spatial_hashing_relationship_detection,
+                       rendering::gui::TOGGLE
                    });
             world.entity("debug_collisions_item_10").child_of(dropdown)
                    .set<rendering::gui::MenuBarTabItem>({
@@ -150,5 +156,28 @@ namespace debug {
                    .set<rendering::gui::MenuBarTabItem>({
                        "Shrink Cell Size", grid_cell_shrink, rendering::gui::RUN
                    });
+
+        // contacts per body are measured either way, flip this to compare them with and without the steering
+        flecs::system toggle_separation = world.system<physics::CrowdSeparation>("Toggle crowd separation")
+                .kind(0)
+                .each([](physics::CrowdSeparation &crowd) { crowd.enabled = !crowd.enabled; });
+        toggle_separation.disable();
+        world.entity("debug_collisions_item_12").child_of(dropdown)
+                .set<rendering::gui::MenuBarTabItem>({
+                    "Toggle Crowd Separation", toggle_separation, rendering::gui::RUN
+                });
+
+        // the detection systems only count pairs per cell while this is on, the heatmap shows the last tick
+        flecs::system toggle_heatmap = world.system<physics::SpatialHashStats>("Toggle spatial hash heatmap")
+                .kind(0)
+                .each([](physics::SpatialHashStats &stats) {
+                    stats.recording = !stats.recording;
+                    stats.cells.clear();
+                });
+        toggle_heatmap.disable();
+        world.entity("debug_collisions_item_13").child_of(dropdown)
+                .set<rendering::gui::MenuBarTabItem>({
+                    "Toggle Spatial Hash Heatmap", toggle_heatmap, rendering::gui::RUN
+                });
     }
 }
@@ -10,16 +10,17 @@
 #include <raymath.h>
 
 #include "modules/engine/core/components.h"
-#include "modules/engine/core/queries.h"
+#include "modules/engine/core/tags.h"
 
 namespace debug::systems {
-    inline void debug_closest_enemy_to_player_system(flecs::iter &iter) {
+    inline void debug_closest_enemy_to_player_system(flecs::iter &iter, flecs::entity_t enemy_tag) {
         auto player = iter.world().lookup("player");
         auto pos = player.get<core::Position2D>();
         float shortest_distance_sqr = 10000000;
         core::Position2D target_pos{pos.value};
-        core::queries::position_and_tag_query.each([&](const core::Position2D &other_pos, const core::Tag &tag) {
-            if ("enemy" != tag.name) return;
+        const auto *enemies = core::tags::positions(iter.world(), enemy_tag);
+        if (!enemies) return;
+        enemies->each([&](const core::Position2D &other_pos) {
             float d = Vector2DistanceSqr(pos.value, other_pos.value);
             if (d > shortest_distance_sqr) return;
             shortest_distance_sqr = d;
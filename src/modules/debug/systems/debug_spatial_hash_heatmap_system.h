@@ -0,0 +1,59 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef DEBUG_SPATIAL_HASH_HEATMAP_SYSTEM_H
+#define DEBUG_SPATIAL_HASH_HEATMAP_SYSTEM_H
+
+#include <algorithm>
+#include <flecs.h>
+#include <raylib.h>
+#include <string>
+
+#include "modules/engine/physics/components.h"
+
+namespace debug::systems {
+    // blue for the quietest cell up to red for the busiest one of the tick
+    inline Color heat_color(int value, int max_value) {
+        float t = max_value > 0 ? static_cast<float>(value) / max_value : 0.0f;
+        return ColorAlpha(ColorFromHSV(240.0f * (1.0f - t), 0.85f, 0.9f), 0.2f + 0.4f * t);
+    }
+
+    inline void debug_spatial_hash_heatmap_system(const physics::SpatialHashingGrid &grid,
+                                                  const physics::SpatialHashStats &stats) {
+        if (!stats.recording) return;
+
+        int max_pairs = 0;
+        for (const auto &[cell, cell_stats]: stats.cells)
+            max_pairs = std::max(max_pairs, cell_stats.candidate_pairs);
+
+        for (const auto &[cell, cell_stats]: stats.cells) {
+            Rectangle rect{grid.offset.x + cell.first * grid.cell_size, grid.offset.y + cell.second * grid.cell_size,
+                           (float) grid.cell_size, (float) grid.cell_size};
+            DrawRectangleRec(rect, heat_color(cell_stats.candidate_pairs, max_pairs));
+            if (grid.cell_size >= 32) {
+                DrawText(std::to_string(cell_stats.occupancy).c_str(), rect.x + 2, rect.y + 2, 10, WHITE);
+                DrawText(std::to_string(cell_stats.candidate_pairs).c_str(), rect.x + 2, rect.y + 12, 10, YELLOW);
+            }
+        }
+    }
+
+    inline void debug_spatial_hash_stats_system(const physics::SpatialHashStats &stats) {
+        if (!stats.recording) return;
+
+        int occupancy = 0, candidate_pairs = 0, hits = 0;
+        for (const auto &[cell, cell_stats]: stats.cells) {
+            occupancy += cell_stats.occupancy;
+            candidate_pairs += cell_stats.candidate_pairs;
+            hits += cell_stats.hits;
+        }
+
+        DrawRectangleRec({0, 70, 225, 80}, DARKGRAY);
+        DrawText((std::to_string(stats.cells.size()) + " cells, " + std::to_string(occupancy) + " bodies").c_str(), 10,
+                 75, 15, GREEN);
+        DrawText((std::to_string(candidate_pairs) + " pairs tested").c_str(), 10, 92, 15, GREEN);
+        DrawText((std::to_string(hits) + " hits").c_str(), 10, 109, 15, GREEN);
+        DrawText(TextFormat("detection %.3f ms", stats.detection_seconds * 1000.0), 10, 126, 15, GREEN);
+    }
+}
+#endif //DEBUG_SPATIAL_HASH_HEATMAP_SYSTEM_H
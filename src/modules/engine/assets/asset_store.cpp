@@ -0,0 +1,192 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "asset_store.h"
+
+#include <chrono>
+#include <limits>
+
+namespace assets {
+    // 95 printable ascii characters and the padding LoadFontEx uses
+    constexpr int FONT_GLYPHS = 95;
+    constexpr int FONT_PADDING = 4;
+
+    static std::shared_future<FileBytes> read_file(AssetStore &store, const std::string &path) {
+        if (auto found = store.files.find(path); found != store.files.end()) return found->second;
+
+        std::shared_future<FileBytes> bytes = std::async(std::launch::async, [path]() -> FileBytes {
+            int size = 0;
+            unsigned char *data = LoadFileData(path.c_str(), &size);
+            if (data == nullptr) return nullptr;
+            auto bytes = std::make_shared<std::vector<unsigned char> >(data, data + size);
+            UnloadFileData(data);
+            return bytes;
+        }).share();
+        store.files.emplace(path, bytes);
+        return bytes;
+    }
+
+    static DecodedAsset decode_image(const FileBytes &bytes, const std::string &path) {
+        DecodedAsset decoded{};
+        if (!bytes) {
+            decoded.failed = true;
+            return decoded;
+        }
+        const char *extension = GetFileExtension(path.c_str());
+        decoded.image = LoadImageFromMemory(extension, bytes->data(), static_cast<int>(bytes->size()));
+        decoded.failed = decoded.image.data == nullptr;
+        return decoded;
+    }
+
+    // what LoadFontFromMemory does, minus the texture upload
+    static DecodedAsset decode_font(const FileBytes &bytes, int size) {
+        DecodedAsset decoded{};
+        if (bytes) {
+            decoded.font.baseSize = size;
+            decoded.font.glyphPadding = FONT_PADDING;
+            decoded.font.glyphs = LoadFontData(bytes->data(), static_cast<int>(bytes->size()), size, nullptr,
+                                               FONT_GLYPHS, FONT_DEFAULT);
+        }
+        if (decoded.font.glyphs == nullptr) {
+            decoded.failed = true;
+            return decoded;
+        }
+        decoded.font.glyphCount = FONT_GLYPHS;
+        decoded.image = GenImageFontAtlas(decoded.font.glyphs, &decoded.font.recs, decoded.font.glyphCount, size,
+                                          decoded.font.glyphPadding, 0);
+        for (int i = 0; i < decoded.font.glyphCount; i++) {
+            UnloadImage(decoded.font.glyphs[i].image);
+            decoded.font.glyphs[i].image = ImageFromImage(decoded.image, decoded.font.recs[i]);
+        }
+        return decoded;
+    }
+
+    static AssetHandle add(AssetStore &store, AssetKind kind, const std::string &key,
+                           std::shared_future<DecodedAsset> decoding) {
+        uint32_t id = static_cast<uint32_t>(store.entries.size());
+        store.entries.push_back({kind, key, std::move(decoding), false, false, {}, {}, {}, {}});
+        store.by_key.emplace(key, id);
+        store.pending.push_back(id);
+        return {id};
+    }
+
+    static const AssetEntry *ready_entry(const AssetStore &store, AssetHandle handle, AssetKind kind) {
+        if (handle.id >= store.entries.size()) return nullptr;
+        const AssetEntry &entry = store.entries[handle.id];
+        if (!entry.ready || entry.failed || entry.kind != kind) return nullptr;
+        return &entry;
+    }
+
+    AssetHandle request_texture(AssetStore &store, const std::string &path) {
+        const std::string key = "texture:" + path;
+        if (auto found = store.by_key.find(key); found != store.by_key.end()) return {found->second};
+
+        std::shared_future<FileBytes> bytes = read_file(store, path);
+        return add(store, TEXTURE, key, std::async(std::launch::async, [bytes, path]() {
+            return decode_image(bytes.get(), path);
+        }).share());
+    }
+
+    AssetHandle request_font(AssetStore &store, const std::string &path, int size) {
+        const std::string key = "font:" + path + "@" + std::to_string(size);
+        if (auto found = store.by_key.find(key); found != store.by_key.end()) return {found->second};
+
+        std::shared_future<FileBytes> bytes = read_file(store, path);
+        return add(store, FONT, key, std::async(std::launch::async, [bytes, size]() {
+            return decode_font(bytes.get(), size);
+        }).share());
+    }
+
+    AssetHandle request_image(AssetStore &store, const std::string &path) {
+        const std::string key = "image:" + path;
+        if (auto found = store.by_key.find(key); found != store.by_key.end()) return {found->second};
+
+        std::shared_future<FileBytes> bytes = read_file(store, path);
+        return add(store, IMAGE, key, std::async(std::launch::async, [bytes, path]() {
+            DecodedAsset decoded = decode_image(bytes.get(), path);
+            if (!decoded.failed) ImageFormat(&decoded.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            return decoded;
+        }).share());
+    }
+
+    AssetHandle request_data(AssetStore &store, const std::string &key, std::function<std::shared_ptr<void>()> load) {
+        const std::string data_key = "data:" + key;
+        if (auto found = store.by_key.find(data_key); found != store.by_key.end()) return {found->second};
+
+        return add(store, DATA, data_key, std::async(std::launch::async, [load = std::move(load)]() {
+            DecodedAsset decoded{};
+            decoded.data = load();
+            decoded.failed = decoded.data == nullptr;
+            return decoded;
+        }).share());
+    }
+
+    bool failed(const AssetStore &store, AssetHandle handle) {
+        if (handle.id >= store.entries.size()) return true;
+        return store.entries[handle.id].ready && store.entries[handle.id].failed;
+    }
+
+    const Texture2D *get_texture(const AssetStore &store, AssetHandle handle) {
+        const AssetEntry *entry = ready_entry(store, handle, TEXTURE);
+        return entry ? &entry->texture : nullptr;
+    }
+
+    const Font *get_font(const AssetStore &store, AssetHandle handle) {
+        const AssetEntry *entry = ready_entry(store, handle, FONT);
+        return entry ? &entry->font : nullptr;
+    }
+
+    const Image *get_image(const AssetStore &store, AssetHandle handle) {
+        const AssetEntry *entry = ready_entry(store, handle, IMAGE);
+        return entry ? &entry->image : nullptr;
+    }
+
+    size_t upload(AssetStore &store, size_t budget) {
+        size_t uploaded = 0;
+        for (auto it = store.pending.begin(); it != store.pending.end();) {
+            if (uploaded > 0 && uploaded >= budget) break;
+
+            AssetEntry &entry = store.entries[*it];
+            if (entry.decoding.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+
+            DecodedAsset decoded = entry.decoding.get();
+            entry.failed = decoded.failed;
+            if (!decoded.failed) {
+                switch (entry.kind) {
+                    case TEXTURE:
+                        entry.texture = LoadTextureFromImage(decoded.image);
+                        uploaded += static_cast<size_t>(decoded.image.width) * decoded.image.height * 4;
+                        UnloadImage(decoded.image);
+                        break;
+                    case FONT:
+                        entry.font = decoded.font;
+                        entry.font.texture = LoadTextureFromImage(decoded.image);
+                        uploaded += static_cast<size_t>(decoded.image.width) * decoded.image.height * 4;
+                        UnloadImage(decoded.image);
+                        break;
+                    case IMAGE:
+                        entry.image = decoded.image;
+                        break;
+                    case DATA:
+                        entry.data = decoded.data;
+                        break;
+                }
+            }
+            entry.ready = true;
+            entry.decoding = {};
+            it = store.pending.erase(it);
+        }
+        store.uploaded_last_frame = uploaded;
+        return uploaded;
+    }
+
+    void finish(AssetStore &store) {
+        for (uint32_t id: store.pending)
+            store.entries[id].decoding.wait();
+        upload(store, std::numeric_limits<size_t>::max());
+    }
+}
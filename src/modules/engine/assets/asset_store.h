@@ -0,0 +1,52 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "components.h"
+
+namespace assets {
+    // png, or anything raylib decodes, uploaded as a texture
+    AssetHandle request_texture(AssetStore &store, const std::string &path);
+
+    // the ttf is read once for every size, each size is rasterized on its own worker
+    AssetHandle request_font(AssetStore &store, const std::string &path, int size);
+
+    // decoded pixels only, never uploaded, for the CPU image ops
+    AssetHandle request_image(AssetStore &store, const std::string &path);
+
+    // runs the load on a worker, the key deduplicates the requests like a path does
+    AssetHandle request_data(AssetStore &store, const std::string &key, std::function<std::shared_ptr<void>()> load);
+
+    // nullptr until the asset is uploaded or when it failed to load
+    const Texture2D *get_texture(const AssetStore &store, AssetHandle handle);
+    const Font *get_font(const AssetStore &store, AssetHandle handle);
+    const Image *get_image(const AssetStore &store, AssetHandle handle);
+
+    // the load is over and gave nothing, the getters will keep returning nullptr
+    bool failed(const AssetStore &store, AssetHandle handle);
+
+    template<typename T>
+    const T *get_data(const AssetStore &store, AssetHandle handle) {
+        if (handle.id >= store.entries.size() || !store.entries[handle.id].ready) return nullptr;
+        return static_cast<const T *>(store.entries[handle.id].data.get());
+    }
+
+    /**
+     * Uploads the decoded assets in request order until the budget is spent, the ones still decoding are skipped.
+     * Main thread only.
+     * @return the uploaded bytes
+     */
+    size_t upload(AssetStore &store, size_t budget);
+
+    // blocks until every request is decoded and uploaded
+    void finish(AssetStore &store);
+}
+
+#endif //ASSET_STORE_H
@@ -0,0 +1,24 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "assets_module.h"
+
+#include "asset_store.h"
+#include "modules/engine/core/components.h"
+#include "systems/upload_assets_system.h"
+
+namespace assets {
+    void AssetsModule::register_components(flecs::world &world) {
+        world.component<AssetStore>().add(flecs::Singleton);
+        // about a 2k texture per frame
+        world.set<AssetStore>({{}, {}, {}, {}, 16 * 1024 * 1024, 0});
+    }
+
+    void AssetsModule::register_systems(flecs::world &world) {
+        world.system<AssetStore>("Upload assets")
+                .kind(flecs::OnLoad)
+                .each(systems::upload_assets_system)
+                .add<core::MainThread>();
+    }
+}
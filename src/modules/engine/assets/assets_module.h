@@ -0,0 +1,29 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ASSETS_MODULE_H
+#define ASSETS_MODULE_H
+
+#include <flecs.h>
+
+#include "components.h"
+#include "modules/base_module.h"
+
+namespace assets {
+    // import before the modules requesting assets in their registration
+    class AssetsModule : public BaseModule<AssetsModule> {
+        friend class BaseModule<AssetsModule>;
+
+    public:
+        // do not add anything to the constructor, instead change the base class
+        AssetsModule(flecs::world &world) : BaseModule(world) {}
+
+    private:
+        void register_components(flecs::world &world);
+
+        void register_systems(flecs::world &world);
+    };
+}
+
+#endif //ASSETS_MODULE_H
@@ -0,0 +1,74 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ASSETS_COMPONENTS_H
+#define ASSETS_COMPONENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+namespace assets {
+    constexpr uint32_t INVALID_ASSET = 0xFFFFFFFF;
+
+    // index in AssetStore::entries, stays valid for the lifetime of the world
+    struct AssetHandle {
+        uint32_t id;
+    };
+
+    enum AssetKind : uint8_t {
+        TEXTURE,
+        FONT,
+        // decoded pixels kept on the CPU
+        IMAGE,
+        // anything a worker can build, like a parsed map
+        DATA,
+    };
+
+    // what a worker hands back to the main thread
+    struct DecodedAsset {
+        // texture pixels, or the glyph atlas of a font
+        Image image;
+        Font font;
+        std::shared_ptr<void> data;
+        bool failed;
+    };
+
+    struct AssetEntry {
+        AssetKind kind;
+        std::string key;
+        // reset once the asset is uploaded
+        std::shared_future<DecodedAsset> decoding;
+        bool ready;
+        bool failed;
+        Texture2D texture;
+        Font font;
+        Image image;
+        std::shared_ptr<void> data;
+    };
+
+    using FileBytes = std::shared_ptr<const std::vector<unsigned char> >;
+
+    // files are decoded on worker threads and uploaded on the main thread, a few per frame
+    struct AssetStore {
+        std::vector<AssetEntry> entries;
+        // a second request for the same file, or font size, gets the first handle
+        std::unordered_map<std::string, uint32_t> by_key;
+        // read once and shared by the decodes of the same file, like every size of a font
+        std::unordered_map<std::string, std::shared_future<FileBytes> > files;
+        // decoding or waiting for their upload, in request order
+        std::vector<uint32_t> pending;
+        // bytes of GPU uploads per frame, at least one asset is uploaded whatever its size
+        size_t upload_budget;
+        size_t uploaded_last_frame;
+    };
+}
+
+#endif //ASSETS_COMPONENTS_H
@@ -0,0 +1,17 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef UPLOAD_ASSETS_SYSTEM_H
+#define UPLOAD_ASSETS_SYSTEM_H
+
+#include "modules/engine/assets/asset_store.h"
+#include "modules/engine/assets/components.h"
+
+namespace assets::systems {
+    inline void upload_assets_system(AssetStore &store) {
+        if (store.pending.empty()) return;
+        upload(store, store.upload_budget);
+    }
+}
+#endif //UPLOAD_ASSETS_SYSTEM_H
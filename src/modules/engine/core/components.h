@@ -4,6 +4,7 @@
 
 #ifndef CORE_COMPONENTS_H
 #define CORE_COMPONENTS_H
+#include <random>
 #include <raylib.h>
 #include <string>
 
@@ -28,12 +29,23 @@ namespace core {
         std::string name;
     };
 
+    // (TaggedAs, tag) relationship added for every Tag, targets are interned through core::tags
+    struct TaggedAs {};
+
     struct DestroyAfterTime {
         float time;
     };
 
     struct DestroyAfterFrame {};
 
+    // entities reclaimed by the last frame and what it cost, the peak keeps the worst mass death frame
+    struct DestructionStats {
+        int destroyed;
+        double milliseconds;
+        int peak_destroyed;
+        double peak_milliseconds;
+    };
+
     struct Paused {
         bool paused;
     };
@@ -44,9 +56,22 @@ namespace core {
     struct Close {};
     struct Open {};
 
+    // on a system or a phase, it reads input, touches GL or draws so it stays on the thread owning the window when
+    // the simulation runs on its own, see simulation::main_thread_pipeline
+    struct MainThread {};
+
+    // on a MainThread system that doesn't read the world (snapshot draws, buffer swap), the threaded loop leaves it
+    // out of its pipelines and does the same work itself without holding the world lock
+    struct OutsideWorldLock {};
+
     struct ExitRequested {};
     struct ExitConfirmed {};
 
+    // world owned random engine, every gameplay roll goes through it so a seed reproduces a session
+    struct Random {
+        std::mt19937 engine;
+    };
+
 }
 
 #endif //CORE_COMPONENTS_H
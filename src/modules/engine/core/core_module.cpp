@@ -14,10 +14,14 @@
 #include <raymath.h>
 
 #include "queries.h"
-#include "systems/destroy_entity_after_frame_system.h"
-#include "systems/destroy_entity_after_time_system.h"
+#include "tags.h"
+#include "timing_wheel.h"
+#include "systems/advance_timing_wheel_system.h"
+#include "systems/destroy_entities_after_frame_system.h"
+#include "systems/intern_tag_system.h"
 #include "systems/remove_empty_tables_system.h"
 #include "systems/reset_enabled_menus_system.h"
+#include "systems/schedule_destroy_after_time_system.h"
 #include "systems/set_time_scale_on_pause_system.h"
 #include "systems/set_paused_on_entity_disable_system.h"
 #include "systems/set_paused_on_entity_enabled_system.h"
@@ -25,20 +29,28 @@
 #include "systems/enable_entity_on_open_system.h"
 
 namespace core {
-    CoreModule::~CoreModule() {
-        queries::position_and_tag_query = {};
-    }
+    CoreModule::~CoreModule() {}
+
     void CoreModule::register_components(flecs::world &world) {
         world.component<Position2D>();
         world.component<Speed>();
         world.component<GameSettings>().add(flecs::Singleton);
         world.component<Tag>();
+        world.component<TaggedAs>().add(flecs::Exclusive);
+        world.component<tags::TagRegistry>().add(flecs::Singleton);
+        world.add<tags::TagRegistry>();
         world.component<DestroyAfterTime>();
         world.component<DestroyAfterFrame>();
+        world.component<DestructionStats>().add(flecs::Singleton);
+        world.add<DestructionStats>();
+        world.component<Random>().add(flecs::Singleton);
+        world.component<TimingWheel>().add(flecs::Singleton);
+        world.add<TimingWheel>();
     }
 
     void CoreModule::register_queries(flecs::world &world) {
-        queries::position_and_tag_query = world.query<Position2D, Tag>();
+        world.component<queries::Queries>().add(flecs::Singleton);
+        world.add<queries::Queries>();
     }
 
     void CoreModule::register_systems(flecs::world &world) {
@@ -73,17 +85,33 @@ namespace core {
                 .with(flecs::Disabled).filter()
                 .each(systems::enable_entity_on_open_system);
 
-        world.system<DestroyAfterTime>("Destroy entities after time")
+        // prefabs are matched too so their instances inherit the pair instead of adding it one by one
+        world.observer<const Tag>("Intern tag")
+                .with(flecs::Prefab).optional()
+                .event(flecs::OnSet)
+                .each(systems::intern_tag_system);
+
+        // lifetimes are scheduled once on the timing wheel instead of being counted down every frame
+        world.observer<const DestroyAfterTime>("Schedule destroy after time")
+                .event(flecs::OnSet)
+                .each(systems::schedule_destroy_after_time_system);
+
+        world.observer<const DestroyAfterTime>("Cancel destroy after time")
+                .event(flecs::OnRemove)
+                .each(systems::cancel_destroy_after_time_system);
+
+        // expired timers add their tag (DestroyAfterFrame, CooldownCompleted, ...) to any entity
+        world.system<TimingWheel>("Advance timing wheel")
                 .kind(flecs::PostFrame)
-                .write<DestroyAfterFrame>()
-                .multi_threaded()
-                .each(systems::destroy_entity_after_time_system);
+                .write(flecs::Wildcard)
+                .each(systems::advance_timing_wheel_system);
 
+        // deletes tables in bulk, which cannot be deferred
         world.system("Destroy entities after frame")
                 .with<DestroyAfterFrame>()
                 .kind(flecs::PostFrame)
-                .multi_threaded()
-                .each(systems::destroy_entity_after_frame_system);
+                .immediate()
+                .run(systems::destroy_entities_after_frame_system);
 
         world.system(
                     "Remove empty tables to avoid fragmentation in collision (CHANGE TO DONTFRAGMENT WHEN FEATURE IS OUT)")
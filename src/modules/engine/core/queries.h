@@ -4,11 +4,17 @@
 
 #ifndef CORE_QUERIES_H
 #define CORE_QUERIES_H
+#include <unordered_map>
+
 #include <flecs.h>
 
 #include "components.h"
 
 namespace core::queries {
-    inline flecs::query<Position2D, Tag> position_and_tag_query;
+    // cached queries shared by systems of every module, one instance per world
+    struct Queries {
+        // positions of the entities tagged (TaggedAs, tag), keyed by the interned tag entity
+        std::unordered_map<flecs::entity_t, flecs::query<const Position2D>> position_by_tag;
+    };
 }
 #endif //CORE_QUERIES_H
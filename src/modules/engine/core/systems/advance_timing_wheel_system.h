@@ -0,0 +1,29 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ADVANCE_TIMING_WHEEL_SYSTEM_H
+#define ADVANCE_TIMING_WHEEL_SYSTEM_H
+
+#include <flecs.h>
+#include "modules/engine/core/timing_wheel.h"
+
+namespace core::systems {
+    inline void advance_timing_wheel_system(flecs::iter &it, size_t i, TimingWheel &wheel) {
+        std::vector<TimingWheel::Timer> expired;
+        wheel.advance(it.delta_time(), expired);
+
+        for (const TimingWheel::Timer &timer: expired) {
+            if (!it.world().is_alive(timer.entity)) continue;
+
+            flecs::entity e(it.world(), timer.entity);
+            if (timer.callback) {
+                timer.callback(e);
+            } else {
+                e.add(timer.id);
+            }
+        }
+    }
+}
+
+#endif //ADVANCE_TIMING_WHEEL_SYSTEM_H
@@ -0,0 +1,47 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef DESTROY_ENTITIES_AFTER_FRAME_SYSTEM_H
+#define DESTROY_ENTITIES_AFTER_FRAME_SYSTEM_H
+
+#include <chrono>
+#include <flecs.h>
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+
+namespace core::systems {
+    // reclaims every entity tagged this frame at once: the tables holding DestroyAfterFrame are deleted whole
+    // instead of destructing the entities one by one
+    inline void destroy_entities_after_frame_system(flecs::iter &it) {
+        auto start = std::chrono::high_resolution_clock::now();
+        flecs::world world = it.world();
+
+        int count = 0;
+        while (it.next()) {
+            count += static_cast<int>(it.count());
+        }
+
+        if (count > 0) {
+            // collision relationships only live for the frame that produced them, dropping what is left in one
+            // pass per relationship spares every deleted target the lookup of the pairs pointing at it
+            if (ecs_id_in_use(world, ecs_pair(world.id<physics::CollidedWith>(), EcsWildcard)))
+                world.remove_all<physics::CollidedWith>(flecs::Wildcard);
+            if (ecs_id_in_use(world, ecs_pair(world.id<physics::NonFragmentingCollidedWith>(), EcsWildcard)))
+                world.remove_all<physics::NonFragmentingCollidedWith>(flecs::Wildcard);
+
+            world.delete_with<DestroyAfterFrame>();
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        DestructionStats &stats = world.get_mut<DestructionStats>();
+        stats.destroyed = count;
+        stats.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        if (stats.milliseconds > stats.peak_milliseconds) {
+            stats.peak_destroyed = count;
+            stats.peak_milliseconds = stats.milliseconds;
+        }
+    }
+}
+
+#endif //DESTROY_ENTITIES_AFTER_FRAME_SYSTEM_H
@@ -0,0 +1,21 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef INTERN_TAG_SYSTEM_H
+#define INTERN_TAG_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/core/tags.h"
+
+namespace core::systems {
+    // the name stays for display, matching goes through the (TaggedAs, tag) pair
+    inline void intern_tag_system(flecs::entity e, const Tag &tag) {
+        flecs::entity id = tags::intern(e.world(), tag.name);
+        if (!e.has<TaggedAs>(id)) e.add<TaggedAs>(id);
+    }
+}
+
+#endif //INTERN_TAG_SYSTEM_H
@@ -0,0 +1,23 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SCHEDULE_DESTROY_AFTER_TIME_SYSTEM_H
+#define SCHEDULE_DESTROY_AFTER_TIME_SYSTEM_H
+
+#include <flecs.h>
+#include "modules/engine/core/components.h"
+#include "modules/engine/core/timing_wheel.h"
+
+namespace core::systems {
+    inline void schedule_destroy_after_time_system(flecs::entity e, const DestroyAfterTime &time) {
+        e.world().get_mut<TimingWheel>().schedule(e, e.world().id<DestroyAfterFrame>(),
+                                                  TimingWheel::ticks(time.time));
+    }
+
+    inline void cancel_destroy_after_time_system(flecs::entity e, const DestroyAfterTime &time) {
+        e.world().get_mut<TimingWheel>().cancel(e, e.world().id<DestroyAfterFrame>());
+    }
+}
+
+#endif //SCHEDULE_DESTROY_AFTER_TIME_SYSTEM_H
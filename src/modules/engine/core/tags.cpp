@@ -0,0 +1,28 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "tags.h"
+
+#include "queries.h"
+
+namespace core::tags {
+    flecs::entity intern(flecs::world world, const std::string &name) {
+        TagRegistry &registry = world.get_mut<TagRegistry>();
+        if (auto it = registry.ids.find(name); it != registry.ids.end()) {
+            return world.entity(it->second);
+        }
+
+        flecs::entity tag = world.entity();
+        registry.ids.emplace(name, tag.id());
+        world.get_mut<queries::Queries>().position_by_tag.emplace(
+                tag.id(), world.query_builder<const Position2D>().with<TaggedAs>(tag).cached().build());
+        return tag;
+    }
+
+    const flecs::query<const Position2D> *positions(const flecs::world &world, flecs::entity_t tag) {
+        const queries::Queries &queries = world.get<queries::Queries>();
+        auto it = queries.position_by_tag.find(tag);
+        return it != queries.position_by_tag.end() ? &it->second : nullptr;
+    }
+}
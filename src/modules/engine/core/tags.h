@@ -0,0 +1,31 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef CORE_TAGS_H
+#define CORE_TAGS_H
+
+#include <string>
+#include <unordered_map>
+
+#include <flecs.h>
+
+#include "components.h"
+
+namespace core::tags {
+    // every tag name resolved once to the entity used as target of (TaggedAs, tag)
+    struct TagRegistry {
+        std::unordered_map<std::string, flecs::entity_t> ids;
+    };
+
+    /**
+     * Returns the entity standing for a tag name, created along with its cached position query on first use.
+     * Resolve tags when registering systems or components, never per entity in a hot loop.
+     */
+    flecs::entity intern(flecs::world world, const std::string &name);
+
+    // cached query over the positions of every entity tagged `tag`, null if the tag was never interned
+    const flecs::query<const Position2D> *positions(const flecs::world &world, flecs::entity_t tag);
+}
+
+#endif //CORE_TAGS_H
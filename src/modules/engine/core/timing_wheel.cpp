@@ -0,0 +1,71 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "timing_wheel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+    uint64_t TimingWheel::ticks(float seconds) {
+        return static_cast<uint64_t>(std::max(1.0f, std::ceil(seconds / TICK_LENGTH)));
+    }
+
+    void TimingWheel::schedule(flecs::entity_t entity, flecs::id_t id, uint64_t delay, Callback callback) {
+        uint32_t generation = ++m_next_generation;
+        m_generations[{entity, id}] = generation;
+        insert({entity, id, m_now + std::clamp<uint64_t>(delay, 1, MAX_DELAY), generation, callback});
+    }
+
+    void TimingWheel::cancel(flecs::entity_t entity, flecs::id_t id) { m_generations.erase({entity, id}); }
+
+    void TimingWheel::advance(float delta_time, std::vector<Timer> &expired) {
+        m_accumulator += delta_time;
+        while (m_accumulator >= TICK_LENGTH) {
+            m_accumulator -= TICK_LENGTH;
+            tick(expired);
+        }
+    }
+
+    void TimingWheel::insert(const Timer &timer) {
+        uint64_t delay = timer.expiry - m_now;
+        int level = 0;
+        while (level < LEVELS - 1 && delay >= uint64_t{1} << (SLOT_BITS * (level + 1))) {
+            level++;
+        }
+        m_slots[level][(timer.expiry >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(timer);
+    }
+
+    void TimingWheel::cascade(int level) {
+        auto &slot = m_slots[level][(m_now >> (SLOT_BITS * level)) & (SLOTS - 1)];
+        std::vector<Timer> timers;
+        timers.swap(slot);
+        for (const Timer &timer: timers) {
+            insert(timer);
+        }
+    }
+
+    void TimingWheel::tick(std::vector<Timer> &expired) {
+        m_now++;
+
+        // when the lower levels wrap around, the matching slot of the level above is spread back down,
+        // highest level first so its timers can keep falling through the levels below it
+        int wrapped = 0;
+        while (wrapped < LEVELS - 1 && (m_now & ((uint64_t{1} << (SLOT_BITS * (wrapped + 1))) - 1)) == 0) {
+            wrapped++;
+        }
+        for (int level = wrapped; level > 0; level--) {
+            cascade(level);
+        }
+
+        auto &slot = m_slots[0][m_now & (SLOTS - 1)];
+        for (const Timer &timer: slot) {
+            auto it = m_generations.find({timer.entity, timer.id});
+            if (it == m_generations.end() || it->second != timer.generation) continue;
+            m_generations.erase(it);
+            expired.push_back(timer);
+        }
+        slot.clear();
+    }
+}
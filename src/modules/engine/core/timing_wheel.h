@@ -0,0 +1,73 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef CORE_TIMING_WHEEL_H
+#define CORE_TIMING_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <flecs.h>
+
+namespace core {
+    /**
+     * Hierarchical timing wheel. Timers are keyed by (entity, id) and either add the id to the entity when they
+     * expire or call a callback, so per tick work only depends on how many timers expire. Scheduling a key again
+     * replaces the previous timer, the stale entry is skipped when its slot comes up.
+     */
+    class TimingWheel {
+    public:
+        using Callback = void (*)(flecs::entity);
+
+        struct Timer {
+            flecs::entity_t entity;
+            flecs::id_t id;
+            uint64_t expiry;
+            uint32_t generation;
+            Callback callback;
+        };
+
+        static constexpr float TICK_LENGTH = 0.016f;
+        static constexpr int SLOT_BITS = 6;
+        static constexpr int SLOTS = 1 << SLOT_BITS;
+        static constexpr int LEVELS = 4;
+        static constexpr uint64_t MAX_DELAY = (uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+
+        static uint64_t ticks(float seconds);
+
+        void schedule(flecs::entity_t entity, flecs::id_t id, uint64_t delay, Callback callback = nullptr);
+        void cancel(flecs::entity_t entity, flecs::id_t id);
+
+        /**
+         * Move the wheel forward by the elapsed time, in whole ticks
+         * @param expired receives the live timers that expired, in expiry order
+         */
+        void advance(float delta_time, std::vector<Timer> &expired);
+
+        [[nodiscard]] uint64_t now() const { return m_now; }
+        [[nodiscard]] size_t size() const { return m_generations.size(); }
+
+    private:
+        struct KeyHash {
+            std::size_t operator()(const std::pair<flecs::entity_t, flecs::id_t> &k) const {
+                return std::hash<flecs::entity_t>{}(k.first) ^ (std::hash<flecs::id_t>{}(k.second) << 1);
+            }
+        };
+
+        void insert(const Timer &timer);
+        void cascade(int level);
+        void tick(std::vector<Timer> &expired);
+
+        uint64_t m_now = 0;
+        float m_accumulator = 0.0f;
+        uint32_t m_next_generation = 0;
+        std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> m_slots;
+        // latest generation of every pending key, anything else in a slot is stale
+        std::unordered_map<std::pair<flecs::entity_t, flecs::id_t>, uint32_t, KeyHash> m_generations;
+    };
+}
+
+#endif //CORE_TIMING_WHEEL_H
@@ -6,6 +6,10 @@
 #ifndef INPUT_COMPONENTS_H
 #define INPUT_COMPONENTS_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace input {
     struct InputHorizontal {
       float value;
@@ -23,6 +27,23 @@ namespace input {
     struct InputToggleEnable {
 
     };
+
+    // one entry per world tick, the axes only ever hold the sum of a few -1/1 key bindings
+    struct InputFrame {
+        int8_t horizontal;
+        int8_t vertical;
+    };
+
+    struct InputRecording {
+        std::string file_path;
+        std::vector<InputFrame> frames;
+        InputFrame current;
+    };
+
+    struct InputPlayback {
+        std::vector<InputFrame> frames;
+        size_t cursor;
+    };
 }
 
 #endif //INPUT_COMPONENTS_H
@@ -5,6 +5,9 @@
 #include "input_module.h"
 
 #include "components.h"
+#include "modules/engine/core/components.h"
+#include "systems/input_playback_system.h"
+#include "systems/input_recording_system.h"
 #include "systems/reset_horizontal_input_system.h"
 #include "systems/reset_vertical_input_system.h"
 #include "systems/set_horizontal_input_system.h"
@@ -16,32 +19,65 @@ namespace input {
         world.component<InputHorizontal>();
         world.component<InputVertical>();
         world.component<KeyBinding>();
+        world.component<InputRecording>().add(flecs::Singleton);
+        world.component<InputPlayback>().add(flecs::Singleton);
     }
 
     void InputModule::register_systems(flecs::world &world) {
+        // cleared before the keys are read rather than after the frame, so that the axes hold between two frames of
+        // the main thread while the simulation ticks on its own
+        world.system<InputHorizontal>("Reset Input Horizontal")
+                .kind(flecs::OnLoad)
+                .each(systems::reset_horizontal_input_system)
+                .add<core::MainThread>();
+
+        world.system<InputVertical>("Reset Input Vertical")
+                .kind(flecs::OnLoad)
+                .each(systems::reset_vertical_input_system)
+                .add<core::MainThread>();
 
         world.system<const KeyBinding, InputHorizontal>("set horizontal input")
                 .term_at(1).cascade()
                 .kind(flecs::PreUpdate)
-                .each(systems::set_horizontal_input_system);
+                .each(systems::set_horizontal_input_system)
+                .add<core::MainThread>();
 
         world.system<const KeyBinding, InputVertical>("set vertical input")
                 .term_at(1).cascade()
                 .kind(flecs::PreUpdate)
-                .each(systems::set_vertical_input_system);
+                .each(systems::set_vertical_input_system)
+                .add<core::MainThread>();
 
         world.system<const KeyBinding, InputToggleEnable>("toggle object enabled")
                 .term_at(1).cascade()
                 .kind(flecs::PreUpdate)
                 .with(flecs::Disabled).optional()
-                .each(systems::toggle_element_on_input_system);
+                .each(systems::toggle_element_on_input_system)
+                .add<core::MainThread>();
 
-        world.system<InputHorizontal>("Reset Input Horizontal")
-                .kind(flecs::PostUpdate)
-                .each(systems::reset_horizontal_input_system);
+        // playback overwrites whatever the key bindings produced, recording then captures the effective input
+        world.system<InputHorizontal, const InputPlayback>("replay horizontal input")
+                .kind(flecs::PreUpdate)
+                .each(systems::replay_horizontal_input_system);
 
-        world.system<InputVertical>("Reset Input Vertical")
-                .kind(flecs::PostUpdate)
-                .each(systems::reset_vertical_input_system);
+        world.system<InputVertical, const InputPlayback>("replay vertical input")
+                .kind(flecs::PreUpdate)
+                .each(systems::replay_vertical_input_system);
+
+        world.system<InputPlayback>("advance input playback")
+                .kind(flecs::PreUpdate)
+                .each(systems::advance_input_playback_system);
+
+        world.system<const InputHorizontal, InputRecording>("record horizontal input")
+                .kind(flecs::PreUpdate)
+                .each(systems::record_horizontal_input_system);
+
+        world.system<const InputVertical, InputRecording>("record vertical input")
+                .kind(flecs::PreUpdate)
+                .each(systems::record_vertical_input_system);
+
+        world.system<InputRecording>("commit recorded input")
+                .kind(flecs::PreUpdate)
+                .each(systems::commit_recorded_input_system);
     }
 }
@@ -0,0 +1,59 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "input_recording.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace input {
+    static constexpr char input_file_magic[4] = {'E', 'C', 'S', 'I'};
+    static constexpr uint32_t input_file_version = 1;
+
+    bool save_input_recording(const std::string &file_path, const InputRecording &recording) {
+        std::ofstream file(file_path, std::ios::binary);
+        if (!file.is_open()) {
+            printf("Failed to open file %s\n", file_path.c_str());
+            return false;
+        }
+
+        uint32_t count = recording.frames.size();
+        file.write(input_file_magic, sizeof(input_file_magic));
+        file.write(reinterpret_cast<const char *>(&input_file_version), sizeof(input_file_version));
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        for (const InputFrame &frame: recording.frames) {
+            file.put(static_cast<char>(frame.horizontal));
+            file.put(static_cast<char>(frame.vertical));
+        }
+        return file.good();
+    }
+
+    bool load_input_playback(const std::string &file_path, InputPlayback &playback) {
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file.is_open()) {
+            printf("Failed to open file %s\n", file_path.c_str());
+            return false;
+        }
+
+        char magic[4];
+        uint32_t version = 0;
+        uint32_t count = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        file.read(reinterpret_cast<char *>(&count), sizeof(count));
+        if (!file || std::memcmp(magic, input_file_magic, sizeof(magic)) != 0 || version != input_file_version) {
+            std::cout << "not an input recording: " << file_path << std::endl;
+            return false;
+        }
+
+        playback.frames.resize(count);
+        for (InputFrame &frame: playback.frames) {
+            frame.horizontal = static_cast<int8_t>(file.get());
+            frame.vertical = static_cast<int8_t>(file.get());
+        }
+        playback.cursor = 0;
+        return file.good();
+    }
+}
@@ -0,0 +1,27 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <string>
+
+#include "components.h"
+
+namespace input {
+    /**
+     * Write the recorded frames to a compact binary file ("ECSI" magic, version, frame count, then two signed
+     * bytes per tick)
+     * @return if the file could be written
+     */
+    bool save_input_recording(const std::string &file_path, const InputRecording &recording);
+
+    /**
+     * Read a file written by save_input_recording into a playback that starts at the first tick
+     * @return if the file could be read
+     */
+    bool load_input_playback(const std::string &file_path, InputPlayback &playback);
+}
+
+#endif //INPUT_RECORDING_H
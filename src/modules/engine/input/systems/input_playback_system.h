@@ -0,0 +1,23 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef INPUT_PLAYBACK_SYSTEM_H
+#define INPUT_PLAYBACK_SYSTEM_H
+
+#include "modules/engine/input/components.h"
+
+namespace input::systems {
+    inline void replay_horizontal_input_system(InputHorizontal &horizontal, const InputPlayback &playback) {
+        horizontal.value = playback.cursor < playback.frames.size() ? playback.frames[playback.cursor].horizontal : 0;
+    }
+
+    inline void replay_vertical_input_system(InputVertical &vertical, const InputPlayback &playback) {
+        vertical.value = playback.cursor < playback.frames.size() ? playback.frames[playback.cursor].vertical : 0;
+    }
+
+    inline void advance_input_playback_system(InputPlayback &playback) {
+        playback.cursor++;
+    }
+}
+#endif //INPUT_PLAYBACK_SYSTEM_H
@@ -0,0 +1,26 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef INPUT_RECORDING_SYSTEM_H
+#define INPUT_RECORDING_SYSTEM_H
+
+#include <cmath>
+
+#include "modules/engine/input/components.h"
+
+namespace input::systems {
+    inline void record_horizontal_input_system(const InputHorizontal &horizontal, InputRecording &recording) {
+        recording.current.horizontal = static_cast<int8_t>(std::lround(horizontal.value));
+    }
+
+    inline void record_vertical_input_system(const InputVertical &vertical, InputRecording &recording) {
+        recording.current.vertical = static_cast<int8_t>(std::lround(vertical.value));
+    }
+
+    inline void commit_recorded_input_system(InputRecording &recording) {
+        recording.frames.push_back(recording.current);
+        recording.current = {0, 0};
+    }
+}
+#endif //INPUT_RECORDING_SYSTEM_H
@@ -4,10 +4,23 @@
 
 #ifndef PHYSICS_COMPONENTS_H
 #define PHYSICS_COMPONENTS_H
+#include <chrono>
+#include <cstdint>
+#include <flecs.h>
 #include <raylib.h>
 #include <vector>
 
 namespace physics {
+    enum PHYSICS_COLLISION_STRATEGY {
+        COLLISION_RELATIONSHIP,
+        COLLISION_RELATIONSHIP_DONTFRAGMENT,
+        COLLISION_ENTITY,
+        RECORD_LIST,
+        SPATIAL_HASH_PER_CELL,
+        SPATIAL_HASH_PER_ENTITY,
+        SPATIAL_HASH_RELATIONSHIP,
+        COUNT
+    };
 
     enum CollisionFilter {
         none = 0x00,
@@ -106,6 +119,104 @@ namespace physics {
 
     struct ContainedIn {};
 
+    // what the spatial hash detection did in one cell during the last detection tick
+    struct CellStats {
+        int occupancy;
+        // pairs that passed the filters and reached the narrowphase
+        int candidate_pairs;
+        int hits;
+    };
+
+    // only filled while recording, the detection systems skip the bookkeeping otherwise. Cleared every detection
+    // tick so it only holds the occupied cells of the last one
+    struct SpatialHashStats {
+        bool recording;
+        uint32_t tick;
+        double detection_seconds;
+        std::unordered_map<std::pair<long, long>, CellStats, IdPairHash> cells;
+    };
+
+    // simulation level of detail, 0 is simulated every tick and higher levels less and less often.
+    // DontFragment so entities drifting between levels never move between tables
+    struct SimulationLod {
+        uint8_t level;
+        // spreads the entities of a level over the ticks of its interval
+        uint8_t slice;
+    };
+
+    struct SimulationLodSettings {
+        // margin around the screen that is still simulated every tick
+        float near_margin;
+        // entities further than this from the camera use the coarsest level
+        float far_distance;
+        // ticks between two updates at each level
+        int intervals[3];
+        uint32_t tick;
+    };
+
+    // bodies steering away from their neighbours in the spatial hash cells before integrating
+    struct Separation {
+        // neighbours closer than this push the body away, harder the closer they are
+        float radius;
+    };
+
+    struct SeparationNeighbour {
+        flecs::entity_t id;
+        Vector2 position;
+    };
+
+    // the Separation bodies bucketed by their position after the last integration, owned by the separation pass so
+    // it doesn't depend on the collision strategy. The origin is fixed at 0, 0 so keys don't move with the camera,
+    // cells are at least as big as the largest Separation radius for the 3x3 lookup to see every neighbour
+    struct SeparationGrid {
+        float cell_size;
+        std::unordered_map<std::pair<long, long>, std::vector<SeparationNeighbour>, IdPairHash> cells;
+    };
+
+    struct CrowdSeparation {
+        bool enabled;
+        // share of the body speed the push can take
+        float weight;
+        // measured every tick whether the steering is enabled or not: bodies with Separation and their
+        // overlapping neighbours, so the contacts per body can be compared with and without it
+        int bodies;
+        int contacts;
+    };
+
+    // walkable/blocked cells of the tilemap, cell (x, y) is centered on origin + (x, y) * cell_size
+    struct CollisionGrid {
+        int width;
+        int height;
+        float cell_size;
+        Vector2 origin;
+        std::vector<uint8_t> blocked;
+    };
+
+    // the systems and observers owned by each strategy, only the ones of the current strategy are enabled
+    struct CollisionStrategy {
+        PHYSICS_COLLISION_STRATEGY current;
+        std::vector<std::vector<flecs::system>> systems;
+        std::vector<std::vector<flecs::entity>> observers;
+        flecs::system spatial_hashing_relationship_detection;
+    };
+
+    struct PhysicsTimings {
+        std::chrono::high_resolution_clock::time_point start_update;
+        std::chrono::high_resolution_clock::time_point end_update;
+        std::chrono::high_resolution_clock::time_point start_detection;
+        std::chrono::high_resolution_clock::time_point end_detection;
+        std::chrono::high_resolution_clock::time_point start_resolution;
+        std::chrono::high_resolution_clock::time_point end_resolution;
+        std::chrono::high_resolution_clock::time_point start_event;
+        std::chrono::high_resolution_clock::time_point end_event;
+        std::chrono::high_resolution_clock::time_point start_cleanup;
+        std::chrono::high_resolution_clock::time_point end_cleanup;
+    };
+
+    struct PhysicsTick {
+        flecs::entity timer;
+    };
+
 
 }
 
@@ -15,7 +15,9 @@
 
 #include "modules/engine/rendering/components.h"
 #include "systems/add_collided_with_system.h"
+#include "systems/assign_simulation_lod_system.h"
 #include "systems/reset_desired_velocity_system.h"
+#include "systems/separate_crowd_system.h"
 #include "systems/update_position_system.h"
 #include "systems/update_velocity_system.h"
 
@@ -39,6 +41,7 @@
 #include "systems/systems_spatial_hashing/collision_detection_spatial_hashing_per_cell_system.h"
 #include "systems/systems_spatial_hashing/collision_detection_spatial_hashing_per_entity_system.h"
 #include "systems/systems_spatial_hashing/init_spatial_hashing_grid_system.h"
+#include "systems/systems_spatial_hashing/spatial_hash_stats_system.h"
 #include "systems/systems_spatial_hashing/update_cell_entities_system.h"
 #include "systems/systems_spatial_hashing/update_grid_on_window_resized_system.h"
 #include "systems/systems_spatial_hashing/update_grid_system.h"
@@ -53,41 +56,21 @@ namespace physics {
 
     PhysicsModule::~PhysicsModule() {}
 
-    void PhysicsModule::set_collision_strategy(PHYSICS_COLLISION_STRATEGY strategy) {
-        for (int i = 0; i < collision_method_systems.size(); i++) {
-            for (auto e: collision_method_systems[i]) {
+    void PhysicsModule::set_collision_strategy(flecs::world world, PHYSICS_COLLISION_STRATEGY strategy) {
+        CollisionStrategy &strategies = world.get_mut<CollisionStrategy>();
+        for (int i = 0; i < strategies.systems.size(); i++) {
+            for (auto e: strategies.systems[i]) {
                 const auto s = static_cast<PHYSICS_COLLISION_STRATEGY>(i);
                 enable_system(e, strategy == s);
             }
         }
-        for (int i = 0; i < collision_method_observers.size(); i++) {
-            for (auto e: collision_method_observers[i]) {
+        for (int i = 0; i < strategies.observers.size(); i++) {
+            for (auto e: strategies.observers[i]) {
                 const auto s = static_cast<PHYSICS_COLLISION_STRATEGY>(i);
                 enable_system(e, strategy == s);
             }
         }
-        physics::strategy = strategy;
-    }
-
-
-    void PhysicsModule::reset_systems_list() {
-        for (auto s: collision_method_systems) {
-            for (auto e: s) {
-                e.destruct();
-            }
-            s.clear();
-        }
-        for (auto s: collision_method_observers) {
-            for (auto e: s) {
-                e.destruct();
-            }
-            s.clear();
-        }
-
-        collision_method_systems.clear();
-        collision_method_observers.clear();
-        collision_method_systems = std::vector<std::vector<flecs::system>>(PHYSICS_COLLISION_STRATEGY::COUNT);
-        collision_method_observers = std::vector<std::vector<flecs::entity>>(PHYSICS_COLLISION_STRATEGY::COUNT);
+        strategies.current = strategy;
     }
 
     void PhysicsModule::register_components(flecs::world &world) {
@@ -96,77 +79,103 @@ namespace physics {
         world.component<CollidedWith>();
         world.component<NonFragmentingCollidedWith>().add(flecs::DontFragment);
         world.component<ContainedIn>().add(flecs::Exclusive);
+        world.component<CollisionGrid>().add(flecs::Singleton);
+        world.component<Separation>();
+        world.component<CrowdSeparation>().add(flecs::Singleton);
+        world.component<SeparationGrid>().add(flecs::Singleton);
+        world.component<SimulationLod>().add(flecs::DontFragment);
+        world.component<SimulationLodSettings>().add(flecs::Singleton);
         world.component<CollisionRecordList>().add(flecs::Singleton);
         world.component<SpatialHashingGrid>().add(flecs::Singleton);
+        world.component<SpatialHashStats>().add(flecs::Singleton);
+        world.component<CollisionStrategy>().add(flecs::Singleton);
+        world.component<PhysicsTimings>().add(flecs::Singleton);
+        world.component<PhysicsTick>().add(flecs::Singleton);
     }
 
-    void PhysicsModule::register_queries(flecs::world &world) {}
+    void PhysicsModule::register_queries(flecs::world &world) {
+        world.component<queries::Queries>().add(flecs::Singleton);
+        world.set<queries::Queries>({world.query_builder<const core::Position2D, const Collider>()
+                                             .with<rendering::Visible>()
+                                             .cached()
+                                             .build()});
+    }
 
     void PhysicsModule::register_systems(flecs::world &world) {
-        m_physicsTick = world.timer().interval(PHYSICS_TICK_LENGTH);
+        world.set<PhysicsTick>({world.timer().interval(PHYSICS_TICK_LENGTH)});
+        world.set<PhysicsTimings>({});
+        world.set<SimulationLodSettings>({64.0f, 1500.0f, {1, 2, 4}, 0});
+        world.set<CrowdSeparation>({true, 0.75f, 0, 0});
+        world.set<SeparationGrid>({48.0f, {}});
+        world.set<SpatialHashStats>({false, 0, 0.0, {}});
+
+        // filled while registering, stored on the world at the end so every world owns its own lists
+        CollisionStrategy strategies{COLLISION_RELATIONSHIP,
+                                     std::vector<std::vector<flecs::system>>(COUNT),
+                                     std::vector<std::vector<flecs::entity>>(COUNT)};
 
 #pragma region "Initialization"
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("init grid normal")
                         .kind(flecs::OnStart)
                         .each(systems::init_spatial_hashing_grid_system));
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("init grid normal per entity")
                         .kind(flecs::OnStart)
                         .each(systems::init_spatial_hashing_grid_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("init grid relationship")
                         .kind(flecs::OnStart)
                         .each(systems::init_spatial_hashing_grid_relationship_system));
 #pragma endregion
 #pragma region "Update"
 
-        world.system("start update").kind(flecs::OnUpdate).run([](flecs::iter &it) {
-            start_update = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("start update").kind(flecs::OnUpdate).each([](PhysicsTimings &timings) {
+            timings.start_update = std::chrono::high_resolution_clock::now();
         });
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("update grid on window resized")
                         .kind(flecs::OnUpdate)
                         .each(systems::update_grid_on_window_resized_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("update grid on window resized per entity")
                         .kind(flecs::OnUpdate)
                         .each(systems::update_grid_on_window_resized_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<SpatialHashingGrid, core::GameSettings>("update grid on window resized relationship")
                         .kind(flecs::OnUpdate)
                         .each(systems::update_grid_on_window_resized_system));
 
-        // collision_method_observers[SPATIAL_HASH_PER_CELL].push_back(
+        // strategies.observers[SPATIAL_HASH_PER_CELL].push_back(
         //         world.observer<SpatialHashingGrid, core::GameSettings>("update grid on grid set")
         //                 .event(flecs::OnSet)
         //                 .each(systems::reset_grid));
         //
-        // collision_method_observers[SPATIAL_HASH_PER_ENTITY].push_back(
+        // strategies.observers[SPATIAL_HASH_PER_ENTITY].push_back(
         //         world.observer<SpatialHashingGrid, core::GameSettings>("update grid on grid set per entity")
         //                 .event(flecs::OnSet)
         //                 .each(systems::reset_grid));
         //
-        // collision_method_observers[SPATIAL_HASH_RELATIONSHIP].push_back(
+        // strategies.observers[SPATIAL_HASH_RELATIONSHIP].push_back(
         //         world.observer<SpatialHashingGrid, core::GameSettings>("update grid on grid set relationship")
         //                 .event(flecs::OnSet)
         //                 .each(systems::reset_grid));
 
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<SpatialHashingGrid, rendering::TrackingCamera, core::GameSettings, GridCell>("update grid")
                         .kind(flecs::PreUpdate)
                         .each(systems::update_grid_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<SpatialHashingGrid, rendering::TrackingCamera, core::GameSettings, GridCell>(
                              "update grid per entity")
                         .kind(flecs::PreUpdate)
                         .each(systems::update_grid_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<SpatialHashingGrid, rendering::TrackingCamera, core::GameSettings, GridCell>(
                              "update grid relationship")
                         .kind(flecs::PreUpdate)
@@ -179,48 +188,93 @@ namespace physics {
 
                 .each(systems::reset_desired_velocity_system);
 
-        world.system<Velocity2D, const DesiredVelocity2D, const AccelerationSpeed>("Lerp Current to Desired Velocity")
+        world.system<SimulationLodSettings>("Advance simulation LOD tick")
+                .kind(flecs::PreUpdate)
+                .each(systems::advance_simulation_lod_tick_system);
+
+        world.system<const core::Position2D, SimulationLod *, const SimulationLodSettings,
+                     const rendering::TrackingCamera, const core::GameSettings>("Assign simulation LOD")
+                .with<Velocity2D>()
+                .kind(flecs::PreUpdate)
+                .each(systems::assign_simulation_lod_system);
+
+        world.system<CrowdSeparation>("Reset crowd stats")
+                .kind(flecs::PreUpdate)
+                .each(systems::reset_crowd_stats_system);
+
+        // first of the phase, the AI has written the desired velocities and nothing has integrated them yet
+        world.system<const core::Position2D, const Collider, const Separation, const core::Speed, DesiredVelocity2D,
+                     const SeparationGrid, CrowdSeparation>("Separate crowd")
+                .kind<UpdateBodies>()
+                .each(systems::separate_crowd_system);
+
+        world.system<Velocity2D, const DesiredVelocity2D, const AccelerationSpeed, const SimulationLod *,
+                     const SimulationLodSettings>("Lerp Current to Desired Velocity")
                 .kind<UpdateBodies>()
 
 
                 .each(systems::update_velocity_system);
 
-        world.system<core::Position2D, const Velocity2D>("Update Position")
+        world.system<core::Position2D, const Velocity2D, const SimulationLod *, const SimulationLodSettings>(
+                     "Update Position")
                 .kind<UpdateBodies>()
 
 
                 .each(systems::update_position_system);
 
+        // filled under every strategy so the separation and its contacts metric are the same workload for all of them
+        world.system<SeparationGrid>("Clear separation grid")
+                .kind<UpdateBodies>()
+                .each(systems::clear_separation_grid_system);
+
+        world.system<const core::Position2D, SeparationGrid>("Fill separation grid")
+                .with<Separation>()
+                .kind<UpdateBodies>()
+                .each(systems::fill_separation_grid_system);
 
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
+                world.system<GridCell>("clear grid cells")
+                        .kind<UpdateBodies>()
+                        .each(systems::clear_grid_cell_system));
+
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
+                world.system<GridCell>("clear grid cells per entity")
+                        .kind<UpdateBodies>()
+                        .each(systems::clear_grid_cell_system));
+
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<SpatialHashingGrid, Collider, core::Position2D>("update entity cells")
                         .without<StaticCollider>()
                         .kind<UpdateBodies>()
                         .each(systems::update_cell_entities_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<SpatialHashingGrid, Collider, core::Position2D>("update entity cells per entity")
                         .without<StaticCollider>()
                         .kind<UpdateBodies>()
                         .each(systems::update_cell_entities_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<SpatialHashingGrid, Collider, core::Position2D>("update entity cells relationship")
                         .without<StaticCollider>()
                         .kind<UpdateBodies>()
                         .each(systems::update_cell_entities_relationship_system));
-        world.system("end update").kind<UpdateBodies>().run([](flecs::iter &it) {
-            end_update = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("end update").kind<UpdateBodies>().each([](PhysicsTimings &timings) {
+            timings.end_update = std::chrono::high_resolution_clock::now();
         });
 #pragma endregion
 
 
 #pragma region "Collision Dectection"
 
-        world.system("start detection").kind<Detection>().run([](flecs::iter &it) {
-            start_detection = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("start detection").kind<Detection>().each([](PhysicsTimings &timings) {
+            timings.start_detection = std::chrono::high_resolution_clock::now();
         });
-        collision_method_systems[COLLISION_RELATIONSHIP].push_back(
+        world.system<SpatialHashStats>("Reset spatial hash stats")
+                .kind<Detection>()
+                .each(systems::reset_spatial_hash_stats_system);
+        strategies.systems[COLLISION_RELATIONSHIP].push_back(
                 world.system<const core::Position2D, const Collider>("Detect Collisions ECS (Relationship)")
                         .with<rendering::Visible>()
                         .kind<Detection>()
@@ -229,7 +283,7 @@ namespace physics {
                         .each(systems::collision_detection_non_static_relationship_system));
 
 
-        collision_method_systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
+        strategies.systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
                 world.system<const core::Position2D, const Collider>("Detect Collisions ECS (Relationship non-frag)")
                         .with<rendering::Visible>()
                         .kind<Detection>()
@@ -237,7 +291,7 @@ namespace physics {
 
                         .each(systems::collision_detection_non_static_relationship_non_fragmenting_system));
 
-        collision_method_systems[COLLISION_ENTITY].push_back(
+        strategies.systems[COLLISION_ENTITY].push_back(
                 world.system<const core::Position2D, const Collider>("Detect Collisions ECS (entity)")
                         .with<rendering::Visible>()
                         .kind<Detection>()
@@ -247,7 +301,7 @@ namespace physics {
                             systems::collision_detection_non_static_entity_system(world, it, i, pos, col);
                         }));
 
-        collision_method_systems[RECORD_LIST].push_back(
+        strategies.systems[RECORD_LIST].push_back(
                 world.system<CollisionRecordList>("Detect Collisions ECS (Naive Record List) non-static")
                         .kind<Detection>()
 
@@ -255,36 +309,40 @@ namespace physics {
                         .each(systems::collision_detection_non_static_record_list_system));
 
 
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
-                world.system<CollisionRecordList, SpatialHashingGrid, GridCell>(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
+                world.system<CollisionRecordList, SpatialHashingGrid, GridCell, SpatialHashStats>(
                              "Detect Collisions ECS non-static with spatial hashing")
                         .kind<Detection>()
                         .each(systems::collision_detection_spatial_hashing_per_cell_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
-                world.system<CollisionRecordList, SpatialHashingGrid, const core::Position2D, const Collider>(
-                             "Detect Collisions ECS non-static with spatial hashing per entity")
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
+                world.system<CollisionRecordList, SpatialHashingGrid, const core::Position2D, const Collider,
+                             SpatialHashStats>("Detect Collisions ECS non-static with spatial hashing per entity")
                         .kind<Detection>()
                         .each(systems::collision_detection_spatial_hashing_per_entity_system));
 
-        m_collision_detection_spatial_ecs =
-                world.system<CollisionRecordList, SpatialHashingGrid, GridCell>("test collision with relationship")
+        strategies.spatial_hashing_relationship_detection =
+                world.system<CollisionRecordList, SpatialHashingGrid, GridCell, SpatialHashStats>(
+                             "test collision with relationship")
                         .kind<Detection>()
 
 
                         .each(systems::collision_detection_relationship_spatial_hashing_system);
-        m_collision_detection_spatial_ecs.disable();
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(m_collision_detection_spatial_ecs);
-        world.system("end detection").kind<Detection>().run([](flecs::iter &it) {
-            end_detection = std::chrono::high_resolution_clock::now();
+        strategies.spatial_hashing_relationship_detection.disable();
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(strategies.spatial_hashing_relationship_detection);
+        world.system<PhysicsTimings>("end detection").kind<Detection>().each([](PhysicsTimings &timings) {
+            timings.end_detection = std::chrono::high_resolution_clock::now();
         });
+        world.system<const PhysicsTimings, SpatialHashStats>("Record spatial hash detection time")
+                .kind<Detection>()
+                .each(systems::record_spatial_hash_time_system);
 
 #pragma endregion
 #pragma region "Resolution"
-        world.system("start resolution").kind<Resolution>().run([](flecs::iter &it) {
-            start_resolution = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("start resolution").kind<Resolution>().each([](PhysicsTimings &timings) {
+            timings.start_resolution = std::chrono::high_resolution_clock::now();
         });
-        collision_method_systems[COLLISION_RELATIONSHIP].push_back(
+        strategies.systems[COLLISION_RELATIONSHIP].push_back(
                 world.system("Resolve Collisions ECS (Relationship)")
                         .with<CollidedWith>(flecs::Wildcard)
                         .kind<Resolution>()
@@ -292,7 +350,7 @@ namespace physics {
 
                         .each(systems::collision_resolution_relationship_system));
 
-        collision_method_systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
+        strategies.systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
                 world.system("Resolve Collisions ECS (Relationship non-frag)")
                         .with<NonFragmentingCollidedWith>(flecs::Wildcard)
                         .kind<Resolution>()
@@ -301,79 +359,79 @@ namespace physics {
                         .each(systems::collision_resolution_relationship_dont_fragment_system));
 
 
-        collision_method_systems[COLLISION_ENTITY].push_back(
+        strategies.systems[COLLISION_ENTITY].push_back(
                 world.system<CollisionRecord>("Resolve Collisions ECS (Entity)")
                         .kind<Resolution>()
                         .immediate()
 
                         .each(systems::collision_resolution_entity_system));
-        collision_method_systems[RECORD_LIST].push_back(
+        strategies.systems[RECORD_LIST].push_back(
                 world.system<CollisionRecordList>("Collision Resolution ECS (Naive Record List) 1")
                         .kind<Resolution>()
 
                         .each(systems::collision_resolution_rec_list_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<CollisionRecordList>("Collision Resolution ECS (spatial hash) ")
                         .kind<Resolution>()
 
                         .each(systems::collision_resolution_rec_list_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<CollisionRecordList>("Collision Resolution ECS (spatial hash) entity")
                         .kind<Resolution>()
 
                         .each(systems::collision_resolution_rec_list_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<CollisionRecordList>("Collision Resolution ECS (spatial hash relationship)")
                         .kind<Resolution>()
 
                         .each(systems::collision_resolution_rec_list_system));
 
-        world.system("end resolution").kind<Resolution>().run([](flecs::iter &it) {
-            end_resolution = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("end resolution").kind<Resolution>().each([](PhysicsTimings &timings) {
+            timings.end_resolution = std::chrono::high_resolution_clock::now();
         });
 
 
 #pragma endregion
 
 #pragma region "collision event"
-        world.system("start event").kind<Resolution>().run([](flecs::iter &it) {
-            start_event = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("start event").kind<Resolution>().each([](PhysicsTimings &timings) {
+            timings.start_event = std::chrono::high_resolution_clock::now();
         });
-        collision_method_systems[RECORD_LIST].push_back(
+        strategies.systems[RECORD_LIST].push_back(
                 world.system<CollisionRecordList>("Add CollidedWith Component 1")
                         .kind<Resolution>()
 
                         .each(systems::add_collided_with_system));
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<CollisionRecordList>("Add CollidedWith Component 2")
                         .kind<Resolution>()
 
                         .each(systems::add_collided_with_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<CollisionRecordList>("Add CollidedWith Component 2 per entity")
                         .kind<Resolution>()
 
                         .each(systems::add_collided_with_system));
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<CollisionRecordList>("Add CollidedWith Component 3")
                         .kind<Resolution>()
 
                         .each(systems::add_collided_with_system));
 
-        world.system("end event").kind<Resolution>().run([](flecs::iter &it) {
-            end_event = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("end event").kind<Resolution>().each([](PhysicsTimings &timings) {
+            timings.end_event = std::chrono::high_resolution_clock::now();
         });
 #pragma endregion
 
 #pragma region "Cleanup"
-        world.system("start cleanup").kind<CollisionCleanup>().run([](flecs::iter &it) {
-            start_cleanup = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("start cleanup").kind<CollisionCleanup>().each([](PhysicsTimings &timings) {
+            timings.start_cleanup = std::chrono::high_resolution_clock::now();
         });
-        collision_method_systems[COLLISION_RELATIONSHIP].push_back(world.system("Collision Cleanup (relationship)")
+        strategies.systems[COLLISION_RELATIONSHIP].push_back(world.system("Collision Cleanup (relationship)")
                                                                            .with<Collider>()
                                                                            .kind<CollisionCleanup>()
                                                                            .immediate()
@@ -381,7 +439,7 @@ namespace physics {
                                                                            .each(systems::collision_cleanup_system));
 
 
-        collision_method_systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
+        strategies.systems[COLLISION_RELATIONSHIP_DONTFRAGMENT].push_back(
                 world.system("Collision Cleanup (dont fragment relationship)")
                         .with<NonFragmentingCollidedWith>(flecs::Wildcard)
                         .with<Collider>()
@@ -390,36 +448,38 @@ namespace physics {
 
                         .each(systems::collision_cleanup_non_frag_system));
 
-        collision_method_systems[COLLISION_ENTITY].push_back(world.system("Collision Cleanup (entity)")
+        strategies.systems[COLLISION_ENTITY].push_back(world.system("Collision Cleanup (entity)")
                                                                      .kind<CollisionCleanup>()
                                                                      .immediate()
 
                                                                      .run(systems::collision_cleanup_entity));
 
-        collision_method_systems[RECORD_LIST].push_back(world.system<CollisionRecordList>("Collision Cleanup List 1")
+        strategies.systems[RECORD_LIST].push_back(world.system<CollisionRecordList>("Collision Cleanup List 1")
                                                                 .kind<CollisionCleanup>()
 
                                                                 .each(systems::collision_cleanup_list_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_CELL].push_back(
+        strategies.systems[SPATIAL_HASH_PER_CELL].push_back(
                 world.system<CollisionRecordList>("Collision Cleanup List 2")
                         .kind<CollisionCleanup>()
                         .each(systems::collision_cleanup_list_system));
 
-        collision_method_systems[SPATIAL_HASH_PER_ENTITY].push_back(
+        strategies.systems[SPATIAL_HASH_PER_ENTITY].push_back(
                 world.system<CollisionRecordList>("Collision Cleanup List 2 entity")
                         .kind<CollisionCleanup>()
                         .each(systems::collision_cleanup_list_system));
 
-        collision_method_systems[SPATIAL_HASH_RELATIONSHIP].push_back(
+        strategies.systems[SPATIAL_HASH_RELATIONSHIP].push_back(
                 world.system<CollisionRecordList>("Collision Cleanup List 3")
                         .kind<CollisionCleanup>()
                         .each(systems::collision_cleanup_list_system));
 
-        world.system("end cleanup").kind<CollisionCleanup>().run([](flecs::iter &it) {
-            end_cleanup = std::chrono::high_resolution_clock::now();
+        world.system<PhysicsTimings>("end cleanup").kind<CollisionCleanup>().each([](PhysicsTimings &timings) {
+            timings.end_cleanup = std::chrono::high_resolution_clock::now();
         });
 #pragma endregion
+
+        world.set<CollisionStrategy>(strategies);
     }
 
     void PhysicsModule::register_pipeline(flecs::world &world) {
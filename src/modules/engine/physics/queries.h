@@ -9,10 +9,13 @@
 
 #include "components.h"
 #include "modules/engine/core/components.h"
+#include "modules/engine/rendering/components.h"
 
 namespace physics::queries {
-    //inline flecs::query<core::Position2D, Collider> visible_collision_bodies_query;
-    //inline flecs::query<core::Position2D, Collider> box_collider_query;
-
+    // cached queries shared by the detection strategies, one instance per world
+    struct Queries {
+        // bodies culled in by the camera, Visible doesn't fragment so culling never invalidates the cache
+        flecs::query<const core::Position2D, const Collider> visible_bodies;
+    };
 }
 #endif //PHYSICS_QUERIES_H
@@ -0,0 +1,23 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SIMULATION_LOD_H
+#define SIMULATION_LOD_H
+
+#include "components.h"
+
+namespace physics::lod {
+    // ticks covered by one update of the entity, entities without a level are always updated
+    inline int interval(const SimulationLod *lod, const SimulationLodSettings &settings) {
+        return lod ? settings.intervals[lod->level] : 1;
+    }
+
+    // round robin: an entity at interval N updates on one tick out of N, offset by its slice
+    inline bool updates_this_tick(const SimulationLod *lod, const SimulationLodSettings &settings) {
+        int n = interval(lod, settings);
+        return n <= 1 || (settings.tick + lod->slice) % n == 0;
+    }
+}
+
+#endif //SIMULATION_LOD_H
@@ -0,0 +1,44 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ASSIGN_SIMULATION_LOD_SYSTEM_H
+#define ASSIGN_SIMULATION_LOD_SYSTEM_H
+
+#include <cmath>
+
+#include <flecs.h>
+#include <raymath.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/engine/rendering/components.h"
+
+namespace physics::systems {
+    inline void advance_simulation_lod_tick_system(SimulationLodSettings &settings) { settings.tick++; }
+
+    inline void assign_simulation_lod_system(flecs::entity e, const core::Position2D &pos, SimulationLod *lod,
+                                             const SimulationLodSettings &settings,
+                                             const rendering::TrackingCamera &camera,
+                                             const core::GameSettings &game_settings) {
+        float zoom = camera.camera.zoom > 0 ? camera.camera.zoom : 1.0f;
+        Vector2 half_view{game_settings.window_width / 2.0f / zoom + settings.near_margin,
+                          game_settings.window_height / 2.0f / zoom + settings.near_margin};
+        Vector2 d = pos.value - camera.camera.target;
+
+        uint8_t level = 2;
+        if (std::abs(d.x) <= half_view.x && std::abs(d.y) <= half_view.y) {
+            level = 0;
+        } else if (Vector2LengthSqr(d) < settings.far_distance * settings.far_distance) {
+            level = 1;
+        }
+
+        if (!lod) {
+            e.set<SimulationLod>({level, static_cast<uint8_t>(e.id() % 256)});
+        } else if (lod->level != level) {
+            lod->level = level;
+        }
+    }
+}
+
+#endif //ASSIGN_SIMULATION_LOD_SYSTEM_H
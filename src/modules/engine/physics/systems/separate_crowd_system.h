@@ -0,0 +1,76 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SEPARATE_CROWD_SYSTEM_H
+#define SEPARATE_CROWD_SYSTEM_H
+
+#include <cmath>
+
+#include <flecs.h>
+#include <raymath.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+
+namespace physics::systems {
+    inline std::pair<long, long> separation_cell(const SeparationGrid &grid, Vector2 position) {
+        return {static_cast<long>(std::floor(position.x / grid.cell_size)),
+                static_cast<long>(std::floor(position.y / grid.cell_size))};
+    }
+
+    inline void reset_crowd_stats_system(CrowdSeparation &crowd) {
+        crowd.bodies = 0;
+        crowd.contacts = 0;
+    }
+
+    inline void clear_separation_grid_system(SeparationGrid &grid) {
+        // cells nobody entered during the last refill are dropped, the others keep their storage
+        std::erase_if(grid.cells, [](const auto &cell) { return cell.second.empty(); });
+        for (auto &[cell, bodies]: grid.cells) bodies.clear();
+    }
+
+    inline void fill_separation_grid_system(flecs::entity e, const core::Position2D &pos, SeparationGrid &grid) {
+        grid.cells[separation_cell(grid, pos.value)].push_back({e.id(), pos.value});
+    }
+
+    /**
+     * Boids style separation: the neighbours found in the 3x3 cells around the body push its desired velocity
+     * away from them, so fewer bodies actually overlap and reach the narrow phase and resolution.
+     * The SeparationGrid holds the positions of the previous tick, it is refilled after integration.
+     */
+    inline void separate_crowd_system(flecs::entity e, const core::Position2D &pos, const Collider &collider,
+                                      const Separation &separation, const core::Speed &speed,
+                                      DesiredVelocity2D &desired, const SeparationGrid &grid,
+                                      CrowdSeparation &crowd) {
+        auto [cell_x, cell_y] = separation_cell(grid, pos.value);
+        const float radius_sqr = separation.radius * separation.radius;
+        const float contact_sqr = collider.bounds.width * collider.bounds.width;
+
+        Vector2 push{0, 0};
+        int contacts = 0;
+        for (long y = cell_y - 1; y <= cell_y + 1; y++) {
+            for (long x = cell_x - 1; x <= cell_x + 1; x++) {
+                auto cell = grid.cells.find({x, y});
+                if (cell == grid.cells.end()) continue;
+                for (const SeparationNeighbour &other: cell->second) {
+                    if (other.id == e.id()) continue;
+                    Vector2 away = pos.value - other.position;
+                    float d_sqr = Vector2LengthSqr(away);
+                    if (d_sqr >= radius_sqr || d_sqr <= 0.0f) continue;
+                    if (d_sqr < contact_sqr) contacts++;
+                    float d = std::sqrt(d_sqr);
+                    push += away / d * (1.0f - d / separation.radius);
+                }
+            }
+        }
+
+        crowd.bodies++;
+        crowd.contacts += contacts;
+        if (!crowd.enabled || (push.x == 0 && push.y == 0)) return;
+
+        desired.value = Vector2ClampValue(desired.value + push * speed.value * crowd.weight, 0.0f, speed.value);
+    }
+}
+
+#endif //SEPARATE_CROWD_SYSTEM_H
@@ -11,14 +11,13 @@
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/collision_helper.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/queries.h"
 
 namespace physics::systems {
     inline void collision_detection_non_static_entity_system(flecs::world world, flecs::iter &self_it, size_t self_id,
                                                              const core::Position2D &pos, const Collider &collider) {
 
-        // Build a staged query, and filter
-        auto visible_query =
-                world.query_builder<const core::Position2D, const Collider>().with<rendering::Visible>().filter();
+        const auto &visible_query = world.get<queries::Queries>().visible_bodies;
         flecs::entity self = self_it.entity(self_id);
 
         visible_query.each([&](flecs::iter &other_it, size_t other_id, const core::Position2D &other_pos,
@@ -10,6 +10,7 @@
 #include <vector>
 #include "modules/engine/physics/components.h"
 #include "modules/engine/core/components.h"
+#include "modules/engine/physics/queries.h"
 #include "modules/engine/rendering/components.h"
 #include "../../collision_helper.h"
 
@@ -19,9 +20,7 @@ namespace physics::systems {
                                                                                    const Collider &collider) {
         flecs::world stage_world = self_it.world();
 
-        // Build a staged query, and filter
-        auto visible_query =
-                stage_world.query_builder<const core::Position2D, const Collider>().with<rendering::Visible>().filter();
+        const auto &visible_query = stage_world.get<queries::Queries>().visible_bodies;
         flecs::entity self = self_it.entity(self_id);
 
         visible_query.each([&](flecs::iter &other_it, size_t other_id, const core::Position2D &other_pos,
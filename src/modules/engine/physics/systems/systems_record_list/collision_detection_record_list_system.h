@@ -10,17 +10,15 @@
 #include <vector>
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/queries.h"
 
 namespace physics::systems {
     inline void collision_detection_non_static_record_list_system(flecs::iter &it, size_t id,
                                                                   CollisionRecordList &list) {
         flecs::world stage_world = it.world();
 
-        // Build a staged query, and filter
-        auto visible_query =
-                stage_world.query_builder<const core::Position2D, const Collider>().with<rendering::Visible>().filter();
-        auto visible_query_1 =
-                stage_world.query_builder<const core::Position2D, const Collider>().with<rendering::Visible>().filter();
+        const auto &visible_query = stage_world.get<queries::Queries>().visible_bodies;
+        const auto &visible_query_1 = visible_query;
         visible_query_1.each(
                 [&](flecs::iter &self_it, size_t self_id, const core::Position2D &other_pos, const Collider &collider) {
                     flecs::entity self = self_it.entity(self_id);
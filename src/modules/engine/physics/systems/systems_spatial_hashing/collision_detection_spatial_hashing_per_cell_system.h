@@ -9,11 +9,18 @@
 
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "spatial_hash_stats_system.h"
 
 namespace physics::systems {
 
     inline void collision_detection_spatial_hashing_per_cell_system(CollisionRecordList &list, SpatialHashingGrid &grid,
-                                                                    GridCell &cell) {
+                                                                    GridCell &cell, SpatialHashStats &stats) {
+        // cells stay in the grid once emptied, they have nothing to test nor to record
+        if (cell.entities.empty())
+            return;
+
+        int candidate_pairs = 0;
+        int hits = 0;
         for (int offset_y = -1; offset_y <= 1; offset_y++) {
             for (int offset_x = -1; offset_x <= 1; offset_x++) {
                 int x = cell.x + offset_x;
@@ -35,16 +42,20 @@ namespace physics::systems {
                         if ((collider.collision_filter & other_collider.collision_type) == none)
                             continue;
 
+                        candidate_pairs++;
                         CollisionInfo a_info;
                         CollisionInfo b_info;
                         if (collision_handler[collider.type][other_collider.type](self, collider, a_info, other,
                                                                                   other_collider, b_info)) {
+                            hits++;
                             list.records.push_back({self, other, a_info, b_info});
                         }
                     }
                 }
             }
         }
+        if (stats.recording)
+            record_cell_stats(stats, cell.x, cell.y, cell.entities.size(), candidate_pairs, hits);
     }
 } // namespace physics::systems
 #endif // COLLISION_DETECTION_SPATIAL_HASHING_PER_CELL_SYSTEM_H
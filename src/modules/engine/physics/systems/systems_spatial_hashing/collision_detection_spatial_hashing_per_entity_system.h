@@ -9,13 +9,15 @@
 
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "spatial_hash_stats_system.h"
 
 namespace physics::systems {
 
     inline void collision_detection_spatial_hashing_per_entity_system(flecs::entity e, CollisionRecordList &list,
                                                                       SpatialHashingGrid &grid,
                                                                       const core::Position2D &pos,
-                                                                      const Collider collider) {
+                                                                      const Collider collider,
+                                                                      SpatialHashStats &stats) {
 
         int cell_pos_x = std::floor((pos.value.x - grid.offset.x) / grid.cell_size);
         int cell_pos_y = std::floor((pos.value.y - grid.offset.y) / grid.cell_size);
@@ -24,6 +26,8 @@ namespace physics::systems {
             return;
         }
         flecs::entity cell = grid.cells[std::make_pair(cell_pos_x, cell_pos_y)];
+        int candidate_pairs = 0;
+        int hits = 0;
         for (int offset_y = -1; offset_y <= 1; offset_y++) {
             for (int offset_x = -1; offset_x <= 1; offset_x++) {
                 int x = cell.get<GridCell>().x + offset_x;
@@ -42,16 +46,21 @@ namespace physics::systems {
                         if ((collider.collision_filter & other_collider.collision_type) == none)
                             continue;
 
+                        candidate_pairs++;
                         CollisionInfo a_info;
                         CollisionInfo b_info;
                         if (collision_handler[collider.type][other_collider.type](e, collider, a_info, other,
                                                                                   other_collider, b_info)) {
+                            hits++;
                             list.records.push_back({e, other, a_info, b_info});
                         }
                     }
 
             }
         }
+        // every entity adds itself to the occupancy of its cell
+        if (stats.recording)
+            record_cell_stats(stats, cell_pos_x, cell_pos_y, 1, candidate_pairs, hits);
     }
 } // namespace physics::systems
 #endif // COLLISION_DETECTION_SPATIAL_HASHING_PER_ENTITY_SYSTEM_H
@@ -0,0 +1,33 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SPATIAL_HASH_STATS_SYSTEM_H
+#define SPATIAL_HASH_STATS_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/physics/components.h"
+
+namespace physics::systems {
+    inline void record_cell_stats(SpatialHashStats &stats, int x, int y, int occupancy, int candidate_pairs,
+                                  int hits) {
+        CellStats &cell = stats.cells[std::make_pair(x, y)];
+        cell.occupancy += occupancy;
+        cell.candidate_pairs += candidate_pairs;
+        cell.hits += hits;
+    }
+
+    inline void reset_spatial_hash_stats_system(SpatialHashStats &stats) {
+        if (!stats.recording) return;
+        // keeps the buckets, the same cells are mostly occupied again next tick
+        stats.cells.clear();
+        stats.tick++;
+    }
+
+    inline void record_spatial_hash_time_system(const PhysicsTimings &timings, SpatialHashStats &stats) {
+        if (!stats.recording) return;
+        stats.detection_seconds = std::chrono::duration<double>(timings.end_detection - timings.start_detection).count();
+    }
+} // namespace physics::systems
+#endif // SPATIAL_HASH_STATS_SYSTEM_H
@@ -18,7 +18,10 @@ namespace physics::systems {
         grid.offset = cam.camera.target - Vector2{
             settings.window_width / 2.0f, settings.window_height / 2.0f
         };
+    }
 
+    // emptied right before being refilled so the steering before integration still sees last tick's neighbours
+    inline void clear_grid_cell_system(GridCell &cell) {
         cell.entities.clear();
     }
 }
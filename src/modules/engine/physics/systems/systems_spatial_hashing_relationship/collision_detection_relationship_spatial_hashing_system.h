@@ -9,11 +9,13 @@
 
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/systems/systems_spatial_hashing/spatial_hash_stats_system.h"
 
 namespace physics::systems {
     inline void collision_detection_relationship_spatial_hashing_system(flecs::iter &it, size_t i,
                                                                         CollisionRecordList &list,
-                                                                        SpatialHashingGrid &grid, GridCell &cell) {
+                                                                        SpatialHashingGrid &grid, GridCell &cell,
+                                                                        SpatialHashStats &stats) {
         flecs::entity current_cell = it.entity(i);
         auto cur_q = it.world()
                              .query_builder<const core::Position2D, const Collider>()
@@ -21,6 +23,8 @@ namespace physics::systems {
                              .filter();
 
         std::vector<CollisionRecord> collisions;
+        int candidate_pairs = 0;
+        int hits = 0;
         for (int offset_y = -1; offset_y <= 1; offset_y++) {
             for (int offset_x = -1; offset_x <= 1; offset_x++) {
                 int x = cell.x + offset_x;
@@ -48,9 +52,11 @@ namespace physics::systems {
                         if ((collider.collision_filter & other_collider.collision_type) == none)
                             return;
 
+                        candidate_pairs++;
                         CollisionInfo a_info, b_info;
                         if (collision_handler[collider.type][other_collider.type](self, collider, a_info, other,
                                                                                   other_collider, b_info)) {
+                            hits++;
                             list.records.push_back({self, other, a_info, b_info});
                         }
                     });
@@ -58,6 +64,13 @@ namespace physics::systems {
             }
         }
 
+        if (stats.recording) {
+            // emptied cells stay in the grid, they would only add zeroed entries to the heatmap
+            int occupancy = cur_q.count();
+            if (occupancy > 0)
+                record_cell_stats(stats, cell.x, cell.y, occupancy, candidate_pairs, hits);
+        }
+
         // if (collisions.empty())
         //     return;
         // list_mutex.lock();
@@ -7,17 +7,21 @@
 
 #include "modules/engine/physics/physics_module.h"
 #include "modules/engine/physics/components.h"
+#include "modules/engine/physics/simulation_lod.h"
 
 namespace physics::systems {
-    inline void update_position_system(const flecs::iter &it, size_t i, core::Position2D &pos, const Velocity2D &vel) {
+    inline void update_position_system(const flecs::iter &it, size_t i, core::Position2D &pos, const Velocity2D &vel,
+                                       const SimulationLod *lod, const SimulationLodSettings &lod_settings) {
         // TODO: change back to delta_system_time once bug is figured out
         // for some reason, if a system call from a tick source, the system_delta_time does not
         // get affected by time_scale(0)
         if(it.world().get<core::Paused>().paused) return;
         float dt = std::min(PHYSICS_TICK_LENGTH, it.delta_time());
 
+        // coarse levels integrate their whole interval in one larger step
+        if (!lod::updates_this_tick(lod, lod_settings)) return;
         pos.value = Vector2Add(
-            pos.value, vel.value * PHYSICS_TICK_LENGTH);
+            pos.value, vel.value * PHYSICS_TICK_LENGTH * lod::interval(lod, lod_settings));
     }
 }
 
@@ -0,0 +1,171 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "atlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+#include "modules/engine/assets/asset_store.h"
+
+namespace rendering::atlas {
+    static int next_power_of_two(int value) {
+        int power = 1;
+        while (power < value)
+            power <<= 1;
+        return power;
+    }
+
+    Layout pack(const std::vector<std::string> &names, const std::vector<Vector2> &sizes) {
+        Layout layout{0, 0, {}};
+        layout.entries.resize(names.size());
+
+        std::vector<size_t> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a].y > sizes[b].y; });
+
+        float area = 0;
+        float widest = 0;
+        for (const Vector2 &size: sizes) {
+            area += (size.x + PADDING) * (size.y + PADDING);
+            widest = std::max(widest, size.x + PADDING);
+        }
+        layout.width = next_power_of_two(static_cast<int>(std::max(widest, std::ceil(std::sqrt(area)))));
+
+        float x = 0;
+        float y = 0;
+        float shelf_height = 0;
+        for (size_t index: order) {
+            const Vector2 &size = sizes[index];
+            if (x + size.x + PADDING > layout.width) {
+                x = 0;
+                y += shelf_height;
+                shelf_height = 0;
+            }
+            layout.entries[index] = {names[index], {x + PADDING / 2.0f, y + PADDING / 2.0f, size.x, size.y}};
+            x += size.x + PADDING;
+            shelf_height = std::max(shelf_height, size.y + PADDING);
+        }
+        layout.height = next_power_of_two(static_cast<int>(y + shelf_height));
+        return layout;
+    }
+
+    std::vector<std::string> sprite_files(const std::string &directory, const std::string &atlas_name) {
+        std::vector<std::string> files;
+        if (!std::filesystem::is_directory(directory)) return files;
+        for (const auto &file: std::filesystem::directory_iterator(directory)) {
+            if (file.path().extension() != ".png" || file.path().stem() == atlas_name) continue;
+            files.push_back(file.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    Image bake(const std::vector<std::string> &files, Layout &layout) {
+        std::vector<Image> images;
+        std::vector<std::string> names;
+        std::vector<Vector2> sizes;
+        for (const std::string &file: files) {
+            Image image = LoadImage(file.c_str());
+            if (image.data == nullptr) continue;
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            images.push_back(image);
+            names.push_back(std::filesystem::path(file).stem().string());
+            sizes.push_back({static_cast<float>(image.width), static_cast<float>(image.height)});
+        }
+
+        layout = pack(names, sizes);
+        Image page = GenImageColor(std::max(layout.width, 1), std::max(layout.height, 1), BLANK);
+        for (size_t i = 0; i < images.size(); i++) {
+            Rectangle source{0, 0, sizes[i].x, sizes[i].y};
+            ImageDraw(&page, images[i], source, layout.entries[i].rect, WHITE);
+            UnloadImage(images[i]);
+        }
+        return page;
+    }
+
+    bool save_table(const std::string &path, const Layout &layout) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        auto write = [&file](const auto &value) { file.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+        write(TABLE_MAGIC);
+        write(TABLE_VERSION);
+        write(static_cast<uint32_t>(layout.width));
+        write(static_cast<uint32_t>(layout.height));
+        write(static_cast<uint32_t>(layout.entries.size()));
+        for (const Entry &entry: layout.entries) {
+            write(static_cast<uint16_t>(entry.name.size()));
+            file.write(entry.name.data(), static_cast<std::streamsize>(entry.name.size()));
+            write(entry.rect);
+        }
+        return file.good();
+    }
+
+    bool load_table(const std::string &path, Layout &layout) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        const std::streamoff file_size = file.tellg();
+        file.seekg(0);
+
+        auto read = [&file](auto &value) { file.read(reinterpret_cast<char *>(&value), sizeof(value)); };
+        uint32_t magic = 0, version = 0, width = 0, height = 0, count = 0;
+        read(magic);
+        read(version);
+        if (!file || magic != TABLE_MAGIC || version != TABLE_VERSION) return false;
+        read(width);
+        read(height);
+        read(count);
+        // every entry is at least its name length and rectangle, checked before sizing anything from the count
+        const std::streamoff left = file ? file_size - file.tellg() : -1;
+        if (left < 0 || count > static_cast<uint64_t>(left) / (sizeof(uint16_t) + sizeof(Rectangle))) return false;
+
+        Layout loaded{static_cast<int>(width), static_cast<int>(height), {}};
+        loaded.entries.resize(count);
+        for (Entry &entry: loaded.entries) {
+            uint16_t length = 0;
+            read(length);
+            entry.name.resize(length);
+            file.read(entry.name.data(), length);
+            read(entry.rect);
+        }
+        if (!file) return false;
+        layout = std::move(loaded);
+        return true;
+    }
+
+    Atlas load(assets::AssetStore &store, const std::string &directory, const std::string &name) {
+        const std::string image_path = directory + "/" + name + ".png";
+        const std::string table_path = directory + "/" + name + ".atlas";
+
+        Layout layout{};
+        Texture2D texture{};
+        assets::AssetHandle page{assets::INVALID_ASSET};
+        if (std::filesystem::exists(image_path) && load_table(table_path, layout)) {
+            page = assets::request_texture(store, image_path);
+        } else {
+            TraceLog(LOG_WARNING, "ATLAS: %s isn't baked, packing the sprites at load", table_path.c_str());
+            Image page = bake(sprite_files(directory, name), layout);
+            texture = LoadTextureFromImage(page);
+            UnloadImage(page);
+        }
+
+        // id 0 is a blank rectangle so unknown sprites draw nothing rather than the wrong one
+        Atlas atlas{texture, page, {{0, 0, 0, 0}}, {""}};
+        for (const Entry &entry: layout.entries) {
+            atlas.rects.push_back(entry.rect);
+            atlas.names.push_back(entry.name);
+        }
+        return atlas;
+    }
+
+    uint16_t sprite(const Atlas &atlas, const std::string &name) {
+        auto found = std::find(atlas.names.begin(), atlas.names.end(), name);
+        if (found == atlas.names.end()) return 0;
+        return static_cast<uint16_t>(found - atlas.names.begin());
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace rendering::atlas {
+    constexpr uint32_t TABLE_MAGIC = 0x534C5441; // "ATLS"
+    constexpr uint32_t TABLE_VERSION = 1;
+    // transparent pixels kept around every sprite so filtering never samples a neighbour
+    constexpr int PADDING = 2;
+
+    struct Entry {
+        std::string name;
+        Rectangle rect;
+    };
+
+    struct Layout {
+        int width;
+        int height;
+        std::vector<Entry> entries;
+    };
+
+    /**
+     * Shelf packs the sizes, tallest first, into a power of two sized page. Entries keep the order of the input.
+     * @param sizes width and height of every sprite, in pixels
+     */
+    Layout pack(const std::vector<std::string> &names, const std::vector<Vector2> &sizes);
+
+    // every png of the directory but the atlas itself, sorted so ids don't depend on the file system
+    std::vector<std::string> sprite_files(const std::string &directory, const std::string &atlas_name);
+
+    // packs the images into one page and fills the layout, the sprites are named after their file
+    Image bake(const std::vector<std::string> &files, Layout &layout);
+
+    /**
+     * Binary sub-rect table: magic, version, page size, entry count, then for every entry its name length, name and
+     * rectangle as 4 floats.
+     */
+    bool save_table(const std::string &path, const Layout &layout);
+    bool load_table(const std::string &path, Layout &layout);
+
+    /**
+     * Reads the `.atlas` table of `<directory>/<name>` as baked by the atlas baker and requests its png from the store,
+     * the page is picked up by the atlas page system once uploaded. When either is missing the sprites of the directory
+     * are baked in memory instead, so a fresh checkout still runs. Needs a GL context.
+     */
+    Atlas load(assets::AssetStore &store, const std::string &directory, const std::string &name);
+
+    // id of the sprite named after its file, 0 when it isn't packed
+    uint16_t sprite(const Atlas &atlas, const std::string &name);
+}
+
+#endif //ATLAS_H
@@ -0,0 +1,44 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "bar_queue.h"
+
+#include <algorithm>
+
+#include <rlgl.h>
+
+namespace rendering::bar_queue {
+    static void quad(const Rectangle &rect, Color color) {
+        // flushes a full vertex buffer and restores the mode
+        rlCheckRenderBatchLimit(4);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(rect.x, rect.y);
+        rlVertex2f(rect.x, rect.y + rect.height);
+        rlVertex2f(rect.x + rect.width, rect.y + rect.height);
+        rlVertex2f(rect.x + rect.width, rect.y);
+    }
+
+    void push(BarQueue &queue, Rectangle rect, float fill, Color background, Color foreground) {
+        queue.commands.push_back({rect, std::clamp(fill, 0.0f, 1.0f), background, foreground});
+    }
+
+    void submit(const BarQueue &queue) {
+        if (queue.commands.empty()) return;
+
+        // the default white texture, same as DrawRectangle
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (const BarCommand &command: queue.commands) {
+            quad(command.rect, command.background);
+        }
+        for (const BarCommand &command: queue.commands) {
+            Rectangle filled = command.rect;
+            filled.width *= command.fill;
+            quad(filled, command.foreground);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
@@ -0,0 +1,18 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef BAR_QUEUE_H
+#define BAR_QUEUE_H
+
+#include "components.h"
+
+namespace rendering::bar_queue {
+    // fill is clamped to [0, 1]
+    void push(BarQueue &queue, Rectangle rect, float fill, Color background, Color foreground);
+
+    // every background then every fill as untextured quads of a single batch
+    void submit(const BarQueue &queue);
+}
+
+#endif //BAR_QUEUE_H
@@ -5,20 +5,44 @@
 #ifndef RENDERING_COMPONENTS_H
 #define RENDERING_COMPONENTS_H
 
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <flecs.h>
 #include <raylib.h>
 
+#include "modules/engine/assets/components.h"
+
 namespace rendering {
     struct Priority {int priority;};
     struct Visible {};
 
-    struct Renderable {
+    // every sprite packed in a single texture, see atlas.h
+    struct Atlas {
+        // id 0 until the page requested from the asset store is uploaded
         Texture2D texture;
+        assets::AssetHandle page;
+        // pixel rectangles indexed by Renderable::sprite, 0 is empty
+        std::vector<Rectangle> rects;
+        std::vector<std::string> names;
+    };
+
+    struct Renderable {
+        // sub-rect of the atlas, see atlas::sprite
+        uint16_t sprite;
         Vector2 draw_offset;
         float scale;
         Color tint;
     };
 
+    // whole texture drawn behind the entities, like the baked tilemap layers
+    struct Background {
+        Texture2D texture;
+        Color tint;
+    };
+
     struct TrackingCamera {
         flecs::entity target;
         Camera2D camera {0};
@@ -28,10 +52,63 @@ namespace rendering {
         float angle;
     };
 
-    struct ProgressBar {
-        float min_val;
-        float max_val;
-        float current_val;
+    // one sprite ready to draw, plain data so the queue can be built and checked without a GPU
+    struct SpriteCommand {
+        // priority, texture id then y, see sprite_queue::sort_key
+        uint64_t key;
+        unsigned int texture_id;
+        // normalized texture coordinates of the sprite
+        Rectangle uv;
+        Rectangle dest;
+        Vector2 origin;
+        float rotation;
+        Color tint;
+    };
+
+    // visible sprites of the frame, gathered in PreRender and drawn in Render
+    struct SpriteQueue {
+        std::vector<SpriteCommand> commands;
+        // radix sort ping pong buffer
+        std::vector<SpriteCommand> scratch;
+        // texture switches of the last submission
+        int batches;
+    };
+
+    // untextured bar in world space, the fill covers `fill` of its width from the left
+    struct BarCommand {
+        Rectangle rect;
+        float fill;
+        Color background;
+        Color foreground;
+    };
+
+    // bars of the frame, any module can push to it during PrepareRender
+    struct BarQueue {
+        std::vector<BarCommand> commands;
+    };
+
+    // the sprite and bar queues of one simulation step
+    struct RenderSnapshot {
+        SpriteQueue sprites;
+        BarQueue bars;
+    };
+
+    /**
+     * Published snapshots, kept out of the world by the game so the main thread can draw one while the simulation
+     * steps. The world queues are the back buffer: they are swapped with `published` at the end of a step and the
+     * main thread swaps `front` with it before drawing, the lock is only held for those swaps.
+     */
+    struct RenderSnapshotBuffer {
+        RenderSnapshot published;
+        RenderSnapshot front;
+        // something was published since the main thread last took it
+        bool fresh = false;
+        std::mutex mutex;
+    };
+
+    // the buffer the world publishes to, owned by the game. Nothing is published or drawn while it is unset
+    struct RenderSnapshots {
+        RenderSnapshotBuffer *buffer;
     };
 }
 
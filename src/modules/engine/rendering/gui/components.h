@@ -10,6 +10,7 @@
 #include <functional>
 #include <variant>
 
+#include "modules/engine/assets/components.h"
 #include "modules/engine/core/components.h"
 
 namespace rendering::gui {
@@ -32,7 +33,8 @@ namespace rendering::gui {
     };
 
     struct TexturedElement {
-        Texture2D texture;
+        assets::AssetHandle texture;
+        // an empty source stretches the nine patch over the whole texture, its size isn't known before it's decoded
         NPatchInfo info;
         Color tint;
     };
@@ -48,8 +50,9 @@ namespace rendering::gui {
         Color color;
     };
 
+    // the raylib default font is drawn until a size is uploaded
     struct FontAtlas {
-        std::unordered_map<int, Font> fonts;
+        std::unordered_map<int, assets::AssetHandle> fonts;
     };
 
     struct Outline {
@@ -118,6 +121,29 @@ namespace rendering::gui {
     };
 
     struct WindowResizedEvent{};
+
+    // one baked layer of an element, transparent where nothing was drawn
+    struct CachedLayer {
+        RenderTexture2D target;
+        // relative to the element's rectangle, text can overflow it
+        Rectangle bounds;
+        bool dirty;
+    };
+
+    /**
+     * Static elements, the ones that aren't interactable, are baked into a render texture per layer and only blitted
+     * afterwards. Setting the Text, Outline or TexturedElement or resizing the Rectangle marks the layer dirty, moving
+     * the element doesn't.
+     */
+    struct RetainedElement {
+        CachedLayer panel;
+        CachedLayer text;
+        CachedLayer outline;
+        // size of the rectangle the layers were baked for
+        Vector2 size;
+        // the text was baked before its font was uploaded
+        bool default_font;
+    };
 }
 
 #endif //GUI_COMPONENTS_H
@@ -10,8 +10,10 @@
 #include <raygui.h>
 
 #include "../../rendering/pipeline_steps.h"
+#include "modules/engine/assets/asset_store.h"
 #include "components.h"
 #include "prefabs.h"
+#include "systems/bake_retained_element_system.h"
 #include "systems/check_window_resized_system.h"
 #include "systems/draw_interactable_textured_element_system.h"
 #include "systems/draw_menu_bar_system.h"
@@ -43,12 +45,17 @@ namespace rendering::gui {
         world.component<Font>();
         world.component<prefabs::Panel>().add(flecs::Inheritable);
         world.component<FontAtlas>().add(flecs::Singleton);
+        // owns its render textures, an instance copying its prefab's would free them twice
+        world.component<RetainedElement>().add(flecs::OnInstantiate, flecs::DontInherit);
+        // rasterized on workers from a single read of the ttf
+        assets::AssetStore &store = world.get_mut<assets::AssetStore>();
+        const std::string font_path = "../resources/Spectral-SemiBold.ttf";
         world.set<FontAtlas>({
-            std::unordered_map<int, Font>{
-                {FONT_SIZE_16, LoadFontEx("../resources/Spectral-SemiBold.ttf", FONT_SIZE_16, nullptr, 0)},
-                {FONT_SIZE_32, LoadFontEx("../resources/Spectral-SemiBold.ttf", FONT_SIZE_32, nullptr, 0)},
-                {FONT_SIZE_48, LoadFontEx("../resources/Spectral-SemiBold.ttf", FONT_SIZE_48, nullptr, 0)},
-                {FONT_SIZE_64, LoadFontEx("../resources/Spectral-SemiBold.ttf", FONT_SIZE_64, nullptr, 0)},
+            std::unordered_map<int, assets::AssetHandle>{
+                {FONT_SIZE_16, assets::request_font(store, font_path, FONT_SIZE_16)},
+                {FONT_SIZE_32, assets::request_font(store, font_path, FONT_SIZE_32)},
+                {FONT_SIZE_48, assets::request_font(store, font_path, FONT_SIZE_48)},
+                {FONT_SIZE_64, assets::request_font(store, font_path, FONT_SIZE_64)},
             }
         });
     }
@@ -91,37 +98,85 @@ namespace rendering::gui {
         world.system<const Rectangle>()
                 .with<InteractableElementState>(Normal)
                 .kind(flecs::PreFrame)
-                .each(systems::interactable_transition_to_hovered_system);
+                .each(systems::interactable_transition_to_hovered_system)
+                .add<core::MainThread>();
 
         world.system<const Rectangle>()
                 .with<InteractableElementState>(Hovered)
                 .kind(flecs::PreFrame)
-                .each(systems::interactable_transition_to_pressed_system);
+                .each(systems::interactable_transition_to_pressed_system)
+                .add<core::MainThread>();
 
         world.system<const Rectangle>()
                 .with<InteractableElementState>(Pressed)
                 .kind(flecs::PreFrame)
-                .each(systems::interactable_transition_to_released_system);
+                .each(systems::interactable_transition_to_released_system)
+                .add<core::MainThread>();
 
         world.system<core::GameSettings>("Window Resized")
                 .kind(flecs::PreFrame)
-                .each(systems::check_window_resized_system);
+                .each(systems::check_window_resized_system)
+                .add<core::MainThread>();
 
-        world.system<const TexturedElement, const Rectangle>("Draw Panel")
+        // interactable elements change with every hover and stay immediate, the others are baked once
+        world.observer<const TexturedElement>("retained panel changed")
+                .event(flecs::OnSet)
+                .without<InteractableElement>()
+                .with(flecs::Disabled).optional()
+                .each(systems::retained_panel_changed_observer);
+
+        world.observer<const Text>("retained text changed")
+                .event(flecs::OnSet)
                 .without<InteractableElement>()
+                .with(flecs::Disabled).optional()
+                .each(systems::retained_text_changed_observer);
+
+        world.observer<const Outline>("retained outline changed")
+                .event(flecs::OnSet)
+                .without<InteractableElement>()
+                .with(flecs::Disabled).optional()
+                .each(systems::retained_outline_changed_observer);
+
+        world.observer<RetainedElement>("release retained element")
+                .event(flecs::OnRemove)
+                .with(flecs::Disabled).optional()
+                .each(systems::release_retained_element_observer);
+
+        world.system<RetainedElement, const Rectangle, const TexturedElement *, const Text *, const Outline *,
+                    const FontAtlas, const assets::AssetStore>("Bake retained elements")
+                .kind(flecs::OnStore)
+                .each(systems::bake_retained_element_system)
+                .add<core::MainThread>();
+
+        world.system<const RetainedElement, const Rectangle>("Draw Panel")
+                .with<TexturedElement>()
                 .kind<RenderGUI>()
-                .each(systems::draw_panel_system);
+                .each(systems::draw_retained_panel_system);
 
-        world.system<const TexturedElement, const InteractableElement, const Rectangle>("Draw textured interactable")
+        world.system<const TexturedElement, const InteractableElement, const Rectangle, const assets::AssetStore>(
+                    "Draw textured interactable")
                 .with<InteractableElementState>(flecs::Wildcard)
                 .kind<RenderGUI>()
                 .each(systems::draw_interactable_textured_element_system);
 
-        world.system<const Text, const Rectangle, const InteractableElement*, const FontAtlas>("Draw Text")
+        world.system<const RetainedElement, const Rectangle>("Draw Retained Text")
+                .with<Text>()
+                .kind<RenderGUI>()
+                .each(systems::draw_retained_text_system);
+
+        world.system<const Text, const Rectangle, const InteractableElement*, const FontAtlas,
+                    const assets::AssetStore>("Draw Text")
+                .with<InteractableElement>()
                 .kind<RenderGUI>()
                 .each(systems::draw_text_system);
 
+        world.system<const RetainedElement, const Rectangle>("Draw Retained Outline")
+                .with<Outline>()
+                .kind<RenderGUI>()
+                .each(systems::draw_retained_outline_system);
+
         world.system<const Rectangle, const Outline>("Draw Outline")
+                .with<InteractableElement>()
                 .kind<RenderGUI>()
                 .each(systems::draw_outline_system);
 
@@ -152,24 +207,23 @@ namespace rendering::gui {
         world.system<const Rectangle>()
                 .with<InteractableElementState>(Released)
                 .kind(flecs::PostFrame)
-                .each(systems::interactable_transition_to_normal_system);
+                .each(systems::interactable_transition_to_normal_system)
+                .add<core::MainThread>();
     }
 
     void GUIModule::register_entities(flecs::world &world) {
-        auto panel_texture = LoadTexture("../resources/panel-010.png");
-        auto button_texture = LoadTexture("../resources/panel-009.png");
+        assets::AssetStore &store = world.get_mut<assets::AssetStore>();
+        auto panel_texture = assets::request_texture(store, "../resources/panel-010.png");
+        auto button_texture = assets::request_texture(store, "../resources/panel-009.png");
         world.prefab<prefabs::Panel>().set<TexturedElement>({
             panel_texture,
-            {{0, 0, (float) panel_texture.width, (float) panel_texture.height}, 16, 16, 16, 16, NPATCH_NINE_PATCH}
+            {{0, 0, 0, 0}, 16, 16, 16, 16, NPATCH_NINE_PATCH}
         });
 
         world.prefab<prefabs::Button>()
                 .set<TexturedElement>({
                     button_texture,
-                    {
-                        {0, 0, (float) panel_texture.width, (float) panel_texture.height}, 16, 16, 16, 16,
-                        NPATCH_NINE_PATCH
-                    },
+                    {{0, 0, 0, 0}, 16, 16, 16, 16, NPATCH_NINE_PATCH},
                     ColorAlpha(WHITE, 0.8)
                 })
                 .set<InteractableElement>({
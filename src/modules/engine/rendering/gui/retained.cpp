@@ -0,0 +1,59 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "retained.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <rlgl.h>
+
+namespace rendering::gui::retained {
+    static void release(CachedLayer &layer) {
+        if (layer.target.id != 0) UnloadRenderTexture(layer.target);
+        layer.target = {};
+    }
+
+    void begin(CachedLayer &layer, Rectangle bounds) {
+        const int width = std::max(1, static_cast<int>(std::ceil(bounds.width)));
+        const int height = std::max(1, static_cast<int>(std::ceil(bounds.height)));
+        if (layer.target.id == 0 || layer.target.texture.width != width || layer.target.texture.height != height) {
+            release(layer);
+            layer.target = LoadRenderTexture(width, height);
+        }
+        layer.bounds = bounds;
+
+        BeginTextureMode(layer.target);
+        ClearBackground(BLANK);
+        // the target ends up premultiplied, blending alpha like color would square it
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                                  RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+        rlPushMatrix();
+        rlTranslatef(-bounds.x, -bounds.y, 0);
+    }
+
+    void end(CachedLayer &layer) {
+        rlPopMatrix();
+        EndBlendMode();
+        EndTextureMode();
+        layer.dirty = false;
+    }
+
+    void draw(const CachedLayer &layer, const Rectangle &rect) {
+        if (layer.target.id == 0) return;
+        const Texture2D &texture = layer.target.texture;
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        // render textures are stored bottom up
+        DrawTextureRec(texture, {0, 0, (float) texture.width, (float) -texture.height},
+                       {rect.x + layer.bounds.x, rect.y + layer.bounds.y}, WHITE);
+        EndBlendMode();
+    }
+
+    void release(RetainedElement &element) {
+        release(element.panel);
+        release(element.text);
+        release(element.outline);
+    }
+}
@@ -0,0 +1,28 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef GUI_RETAINED_H
+#define GUI_RETAINED_H
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace rendering::gui::retained {
+    /**
+     * Starts drawing into the layer, everything drawn until end is in the element's coordinates with its rectangle at
+     * the origin. The target is reallocated only when the bounds change size. Not inside BeginDrawing's camera mode.
+     * @param bounds what will be drawn, relative to the element's rectangle
+     */
+    void begin(CachedLayer &layer, Rectangle bounds);
+
+    void end(CachedLayer &layer);
+
+    // blits the baked layer at the element's rectangle, nothing when it was never baked
+    void draw(const CachedLayer &layer, const Rectangle &rect);
+
+    void release(RetainedElement &element);
+}
+
+#endif //GUI_RETAINED_H
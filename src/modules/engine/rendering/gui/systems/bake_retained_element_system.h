@@ -0,0 +1,89 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef BAKE_RETAINED_ELEMENT_SYSTEM_H
+#define BAKE_RETAINED_ELEMENT_SYSTEM_H
+
+#include <flecs.h>
+#include <raylib.h>
+
+#include "draw_outline_system.h"
+#include "draw_panel_system.h"
+#include "draw_text_system.h"
+#include "modules/engine/assets/asset_store.h"
+#include "modules/engine/rendering/gui/components.h"
+#include "modules/engine/rendering/gui/retained.h"
+
+namespace rendering::gui::systems {
+    // runs before the frame begins, render textures can't be bound while the camera is
+    inline void bake_retained_element_system(RetainedElement &element, const Rectangle &rect,
+                                             const TexturedElement *panel, const Text *text, const Outline *outline,
+                                             const FontAtlas &fonts, const assets::AssetStore &store) {
+        if (rect.width != element.size.x || rect.height != element.size.y) {
+            element.size = {rect.width, rect.height};
+            element.panel.dirty = element.text.dirty = element.outline.dirty = true;
+        }
+        const Rectangle local{0, 0, rect.width, rect.height};
+
+        if (panel && element.panel.dirty) {
+            Texture2D texture;
+            NPatchInfo info;
+            // stays dirty until the texture is uploaded
+            if (resolve_textured_element(*panel, store, texture, info)) {
+                retained::begin(element.panel, local);
+                DrawTextureNPatch(texture, info, local, {0, 0}, 0, ColorAlpha(BLACK, 0.8));
+                retained::end(element.panel);
+            }
+        }
+
+        if (text) {
+            const Font *loaded = assets::get_font(store, fonts.fonts.at(text->font_size));
+            if (element.default_font && loaded) element.text.dirty = true;
+            if (element.text.dirty) {
+                Font font = loaded ? *loaded : GetFontDefault();
+                Vector2 size = MeasureTextEx(font, text->text.c_str(), text->font_size, 0);
+                Vector2 pos = text_position(*text, local, size);
+                retained::begin(element.text, {pos.x, pos.y, size.x, size.y});
+                DrawTextEx(font, text->text.c_str(), pos, text->font_size, 0, text->color);
+                retained::end(element.text);
+                element.default_font = !loaded;
+            }
+        }
+
+        if (outline && element.outline.dirty) {
+            retained::begin(element.outline, local);
+            draw_outline_system(local, *outline);
+            retained::end(element.outline);
+        }
+    }
+
+    inline void draw_retained_panel_system(const RetainedElement &element, const Rectangle &rect) {
+        retained::draw(element.panel, rect);
+    }
+
+    inline void draw_retained_text_system(const RetainedElement &element, const Rectangle &rect) {
+        retained::draw(element.text, rect);
+    }
+
+    inline void draw_retained_outline_system(const RetainedElement &element, const Rectangle &rect) {
+        retained::draw(element.outline, rect);
+    }
+
+    inline void retained_panel_changed_observer(flecs::entity e, const TexturedElement &) {
+        e.ensure<RetainedElement>().panel.dirty = true;
+    }
+
+    inline void retained_text_changed_observer(flecs::entity e, const Text &) {
+        e.ensure<RetainedElement>().text.dirty = true;
+    }
+
+    inline void retained_outline_changed_observer(flecs::entity e, const Outline &) {
+        e.ensure<RetainedElement>().outline.dirty = true;
+    }
+
+    inline void release_retained_element_observer(RetainedElement &element) {
+        retained::release(element);
+    }
+}
+#endif //BAKE_RETAINED_ELEMENT_SYSTEM_H
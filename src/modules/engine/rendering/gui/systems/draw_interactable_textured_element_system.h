@@ -8,11 +8,16 @@
 #include <raylib.h>
 
 #include "modules/engine/rendering/gui/components.h"
+#include "draw_panel_system.h"
 
 
 namespace rendering::gui::systems {
     inline void draw_interactable_textured_element_system(flecs::entity e, const TexturedElement& tex, const InteractableElement& inter,
-                                   const Rectangle &rect) {
+                                   const Rectangle &rect, const assets::AssetStore &store) {
+        Texture2D texture;
+        NPatchInfo info;
+        if (!resolve_textured_element(tex, store, texture, info)) return;
+
         Color tint;
 
         if (e.has<InteractableElementState>(Hovered)) {
@@ -23,7 +28,7 @@ namespace rendering::gui::systems {
             tint = tex.tint;
         }
 
-        DrawTextureNPatch(tex.texture, tex.info, rect, {0,0}, 0.0f, tint);
+        DrawTextureNPatch(texture, info, rect, {0,0}, 0.0f, tint);
     }
 }
 #endif //DRAW_BUTTON_SYSTEM_H
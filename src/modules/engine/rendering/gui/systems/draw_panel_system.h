@@ -4,11 +4,20 @@
 
 #ifndef DRAW_PANEL_SYSTEM_H
 #define DRAW_PANEL_SYSTEM_H
+#include "modules/engine/assets/asset_store.h"
 #include "modules/engine/rendering/gui/components.h"
 
 namespace rendering::gui::systems {
-    inline void draw_panel_system(flecs::entity e, const TexturedElement &panel, const Rectangle &rect) {
-        DrawTextureNPatch(panel.texture, panel.info, rect, {0,0}, 0, ColorAlpha(BLACK, 0.8));
+    // the nine patch of a texture that may still be loading, false when there is nothing to draw yet
+    inline bool resolve_textured_element(const TexturedElement &element, const assets::AssetStore &store,
+                                         Texture2D &texture, NPatchInfo &info) {
+        const Texture2D *loaded = assets::get_texture(store, element.texture);
+        if (!loaded) return false;
+        texture = *loaded;
+        info = element.info;
+        if (info.source.width == 0 || info.source.height == 0)
+            info.source = {0, 0, (float) texture.width, (float) texture.height};
+        return true;
     }
 }
 
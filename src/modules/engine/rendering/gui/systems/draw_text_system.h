@@ -6,13 +6,13 @@
 #define DRAW_TEXT_SYSTEM_H
 
 #include <raylib.h>
+#include "modules/engine/assets/asset_store.h"
 #include "modules/engine/rendering/gui/components.h"
 #include "modules/engine/rendering/gui/gui_module.h"
 
 namespace rendering::gui::systems {
-    inline void draw_text_system(flecs::entity e, const Text &text, const Rectangle &rect, const InteractableElement *inter, const FontAtlas &fonts) {
+    inline Vector2 text_position(const Text &text, const Rectangle &rect, Vector2 text_size) {
         Vector2 pos;
-        Vector2 text_size = MeasureTextEx(fonts.fonts.at(text.font_size), text.text.c_str(), text.font_size, 0);
         switch (text.alignment) {
             case TEXT_ALIGN_CENTER:
                 pos.x = rect.x + (rect.width - text_size.x) / 2;
@@ -26,9 +26,17 @@ namespace rendering::gui::systems {
                 pos = {rect.x, rect.y};
                 break;
         }
+        return pos;
+    }
+
+    inline void draw_text_system(flecs::entity e, const Text &text, const Rectangle &rect, const InteractableElement *inter, const FontAtlas &fonts,
+                                 const assets::AssetStore &store) {
+        const Font *loaded = assets::get_font(store, fonts.fonts.at(text.font_size));
+        Font font = loaded ? *loaded : GetFontDefault();
+        Vector2 pos = text_position(text, rect, MeasureTextEx(font, text.text.c_str(), text.font_size, 0));
 
         if (!inter) {
-            DrawTextEx(fonts.fonts.at(text.font_size), text.text.c_str(), pos, text.font_size, 0, text.color);
+            DrawTextEx(font, text.text.c_str(), pos, text.font_size, 0, text.color);
             return;
         }
 
@@ -53,7 +61,7 @@ namespace rendering::gui::systems {
             text_col = use_black ? DARKGRAY : LIGHTGRAY;
         }
 
-        DrawTextEx(fonts.fonts.at(text.font_size), text.text.c_str(), pos, text.font_size, 0, text_col);
+        DrawTextEx(font, text.text.c_str(), pos, text.font_size, 0, text_col);
 
     }
 }
@@ -6,12 +6,20 @@
 #define RENDERING_PIPELINE_STEPS_H
 
 namespace rendering {
+    // culls and queues the frame, nothing is drawn so it can run with the simulation
+    struct PrepareRender{};
+    // hands the queues over to the RenderSnapshotBuffer
+    struct PublishRender{};
     struct PreRender{};
     struct RenderBackground{};
     struct RenderGizmos{};
     struct Render{};
     struct RenderGUI{};
     struct PostRender{};
+
+    // on RenderGizmos and so on every phase after it, what is drawn over the sprites. The threaded loop runs them
+    // once the snapshot is drawn, see simulation::overlay_pipeline
+    struct Overlay{};
 }
 
 #endif //RENDERING_PIPELINE_STEPS_H
@@ -0,0 +1,31 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "render_snapshot.h"
+
+#include <utility>
+
+#include "bar_queue.h"
+#include "sprite_queue.h"
+
+namespace rendering::render_snapshot {
+    void publish(RenderSnapshotBuffer &buffer, SpriteQueue &sprites, BarQueue &bars) {
+        std::lock_guard lock(buffer.mutex);
+        std::swap(buffer.published.sprites, sprites);
+        std::swap(buffer.published.bars, bars);
+        buffer.fresh = true;
+    }
+
+    void acquire(RenderSnapshotBuffer &buffer) {
+        std::lock_guard lock(buffer.mutex);
+        if (!buffer.fresh) return;
+        std::swap(buffer.front, buffer.published);
+        buffer.fresh = false;
+    }
+
+    void draw(RenderSnapshotBuffer &buffer) {
+        sprite_queue::submit(buffer.front.sprites);
+        bar_queue::submit(buffer.front.bars);
+    }
+}
@@ -0,0 +1,21 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "components.h"
+
+namespace rendering::render_snapshot {
+    // hand the queues over, they come back holding an older snapshot to be cleared and reused
+    void publish(RenderSnapshotBuffer &buffer, SpriteQueue &sprites, BarQueue &bars);
+
+    // bring the latest published snapshot to the front, the front stays as it was when nothing new was published
+    void acquire(RenderSnapshotBuffer &buffer);
+
+    // the sprites then the bars of the front snapshot, only the main thread touches it so no lock is taken
+    void draw(RenderSnapshotBuffer &buffer);
+}
+
+#endif //RENDER_SNAPSHOT_H
@@ -16,9 +16,11 @@
 #include "systems/begin_drawing_system.h"
 #include "systems/create_camera_system.h"
 #include "systems/determine_visible_entities_system.h"
+#include "systems/draw_bar_queue_system.h"
 #include "systems/draw_entity_with_texture_system.h"
-#include "systems/draw_health_bar_system.h"
 #include "systems/end_drawing_system.h"
+#include "systems/queue_sprites_system.h"
+#include "systems/resolve_atlas_page_system.h"
 #include "systems/update_and_begin_camera_mode_system.h"
 
 
@@ -28,7 +30,13 @@ rendering::RenderingModule::~RenderingModule() {
 }
 void rendering::RenderingModule::register_components(flecs::world world) {
     world.component<Priority>();
+    // culling flips this on thousands of entities at the screen edge, keep it out of the archetype
+    world.component<Visible>().add(flecs::DontFragment);
     world.component<TrackingCamera>().add(flecs::Singleton);
+    world.component<SpriteQueue>().add(flecs::Singleton);
+    world.component<Atlas>().add(flecs::Singleton);
+    world.component<BarQueue>().add(flecs::Singleton);
+    world.component<RenderSnapshots>().add(flecs::Singleton);
 }
 
 void rendering::RenderingModule::register_queries(flecs::world world) {
@@ -50,16 +58,13 @@ void rendering::RenderingModule::register_systems(flecs::world world) {
             .kind<PreRender>()
             .each(systems::update_and_begin_camera_mode_system);
 
-    world.system<const core::Position2D, const Renderable, const core::GameSettings, const TrackingCamera>(
-                "Determine Visible Entities")
-            .write<Visible>()
-            .kind<PreRender>()
-            .multi_threaded()
-            .each(systems::determine_visible_entities_system);
+    world.system<const core::Position2D, const Renderable>("Determine Visible Entities")
+            .kind<PrepareRender>()
+            .immediate()
+            .run(systems::determine_visible_entities_system);
 
-    world.system<const Renderable>("Draw Background Textures")
+    world.system<const Background>("Draw Background Textures")
             .kind<RenderBackground>()
-            .without<core::Position2D>()
             .with<Priority>()
             .order_by<Priority>([](flecs::entity_t e1, const Priority *p1, flecs::entity_t e2, const Priority *p2) {
                 int order = p1->priority - p2->priority;
@@ -69,41 +74,61 @@ void rendering::RenderingModule::register_systems(flecs::world world) {
             })
             .each(systems::draw_background_textures_system);
 
-    world.system<const Renderable, const core::Position2D, const Rotation *>("Draw Entities with Textures")
-            .kind<Render>()
+    world.system<Atlas, const assets::AssetStore>("Resolve Atlas Page")
+            .kind<PreRender>()
+            .each(systems::resolve_atlas_page_system);
+
+    world.set<SpriteQueue>({{}, {}, 0});
+    world.set<BarQueue>({});
+    world.set<RenderSnapshots>({nullptr});
+    world.system<const Renderable, const core::Position2D, const Rotation *, const Priority>("Queue Sprites")
+            .kind<PrepareRender>()
             .with<Visible>()
-            .with<Priority>()
-            .order_by<Priority>([](flecs::entity_t e1, const Priority *p1, flecs::entity_t e2, const Priority *p2) {
-                int order = p1->priority - p2->priority;
-                if (order == 0)
-                    return static_cast<int>(e1 - e2);
-                return p1->priority - p2->priority;
-            })
-            .each(systems::draw_entity_with_texture_system);
+            .run(systems::queue_sprites_system);
+
+    world.system<SpriteQueue, BarQueue, const RenderSnapshots>("Publish Render Snapshot")
+            .kind<PublishRender>()
+            .each(systems::publish_render_snapshot_system);
 
+    world.system<const RenderSnapshots>("Acquire Render Snapshot")
+            .kind<PreRender>()
+            .each(systems::acquire_render_snapshot_system);
+
+    // only read the snapshot buffer, the threaded loop draws it itself without the world lock
+    world.system<const RenderSnapshots>("Draw Sprite Queue")
+            .kind<Render>()
+            .each(systems::draw_sprite_queue_system)
+            .add<core::OutsideWorldLock>();
 
-    world.system<ProgressBar, Rectangle, const core::Position2D, const Renderable>("show healthbar")
-            .term_at(2).parent()
-            .term_at(3).parent()
+    // over the sprites, whatever was pushed to the bar queue before the snapshot
+    world.system<const RenderSnapshots>("Draw Bar Queue")
             .kind<Render>()
-            .each(systems::draw_health_bar_system);
+            .each(systems::draw_bar_queue_system)
+            .add<core::OutsideWorldLock>();
 
     world.system("end camera mode")
             .kind<RenderGUI>()
             .run(systems::end_camera_mode_system);
 
+    // swaps the window buffers, which can block on vsync
     world.system("After Draw")
             .kind<PostRender>()
-            .run(systems::end_drawing_system);
+            .run(systems::end_drawing_system)
+            .add<core::OutsideWorldLock>();
 }
 
 void rendering::RenderingModule::register_pipeline(flecs::world world) {
-    world.component<PreRender>().add(flecs::Phase).depends_on(flecs::OnStore);
-    world.component<RenderBackground>().add(flecs::Phase).depends_on<PreRender>();
-    world.component<Render>().add(flecs::Phase).depends_on<RenderBackground>();
-    world.component<RenderGizmos>().add(flecs::Phase).depends_on<Render>();
-    world.component<RenderGUI>().add(flecs::Phase).depends_on<RenderGizmos>();
-    world.component<PostRender>().add(flecs::Phase).depends_on<RenderGUI>();
+    // level with OnStore, after the collisions are resolved
+    world.component<PrepareRender>().add(flecs::Phase).depends_on(flecs::PreStore);
+    world.component<PublishRender>().add(flecs::Phase).depends_on<PrepareRender>();
+    // the phases that draw stay with the window
+    world.component<PreRender>().add(flecs::Phase).depends_on<PublishRender>().add<core::MainThread>();
+    world.component<RenderBackground>().add(flecs::Phase).depends_on<PreRender>().add<core::MainThread>();
+    world.component<Render>().add(flecs::Phase).depends_on<RenderBackground>().add<core::MainThread>();
+    // everything from here on draws over the snapshot
+    world.component<RenderGizmos>().add(flecs::Phase).depends_on<Render>().add<core::MainThread>().add<Overlay>();
+    world.component<RenderGUI>().add(flecs::Phase).depends_on<RenderGizmos>().add<core::MainThread>();
+    world.component<PostRender>().add(flecs::Phase).depends_on<RenderGUI>().add<core::MainThread>();
 }
 
 void rendering::RenderingModule::register_submodules(flecs::world world) {
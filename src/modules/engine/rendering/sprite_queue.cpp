@@ -0,0 +1,112 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "sprite_queue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <rlgl.h>
+
+namespace rendering::sprite_queue {
+    // flips the float bits so that unsigned comparison matches float ordering, negatives included
+    static uint32_t sortable_float(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+    }
+
+    uint64_t sort_key(int priority, unsigned int texture_id, float y) {
+        uint64_t biased = static_cast<uint64_t>(std::clamp(priority + 0x8000, 0, 0xFFFF));
+        return biased << 48 | static_cast<uint64_t>(texture_id & 0xFFFF) << 32 | sortable_float(y);
+    }
+
+    void push(SpriteQueue &queue, const Atlas &atlas, const Renderable &renderable, Vector2 position, float rotation,
+              int priority) {
+        const Rectangle &rect = atlas.rects[renderable.sprite];
+        const float page_width = static_cast<float>(atlas.texture.width);
+        const float page_height = static_cast<float>(atlas.texture.height);
+        float scaled_width = rect.width * renderable.scale;
+        float scaled_height = rect.height * renderable.scale;
+        queue.commands.push_back({
+                sort_key(priority, atlas.texture.id, position.y),
+                atlas.texture.id,
+                {rect.x / page_width, rect.y / page_height, rect.width / page_width, rect.height / page_height},
+                {position.x + renderable.draw_offset.x * renderable.scale,
+                 position.y + renderable.draw_offset.y * renderable.scale, scaled_width, scaled_height},
+                {scaled_width / 2.0f + renderable.draw_offset.x, scaled_height / 2.0f + renderable.draw_offset.y},
+                rotation,
+                renderable.tint,
+        });
+    }
+
+    void sort(SpriteQueue &queue) {
+        const size_t count = queue.commands.size();
+        if (count < 2) return;
+
+        // a byte every key shares doesn't reorder anything, most frames only sort on y and a few textures
+        uint64_t all_and = ~0ull;
+        uint64_t all_or = 0;
+        for (const SpriteCommand &command: queue.commands) {
+            all_and &= command.key;
+            all_or |= command.key;
+        }
+        const uint64_t varying = all_and ^ all_or;
+
+        queue.scratch.resize(count);
+        for (int shift = 0; shift < 64; shift += 8) {
+            if (((varying >> shift) & 0xFF) == 0) continue;
+
+            size_t offsets[256] = {};
+            for (const SpriteCommand &command: queue.commands)
+                offsets[(command.key >> shift) & 0xFF]++;
+            size_t total = 0;
+            for (size_t &offset: offsets) {
+                size_t bucket = offset;
+                offset = total;
+                total += bucket;
+            }
+            for (const SpriteCommand &command: queue.commands)
+                queue.scratch[offsets[(command.key >> shift) & 0xFF]++] = command;
+            queue.commands.swap(queue.scratch);
+        }
+    }
+
+    void submit(SpriteQueue &queue) {
+        queue.batches = 0;
+        for_each_batch(queue, [&queue](const SpriteCommand *first, size_t count) {
+            queue.batches++;
+            rlSetTexture(first->texture_id);
+            rlBegin(RL_QUADS);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (size_t i = 0; i < count; i++) {
+                const SpriteCommand &command = first[i];
+                // flushes a full vertex buffer and restores the texture and mode
+                rlCheckRenderBatchLimit(4);
+                rlColor4ub(command.tint.r, command.tint.g, command.tint.b, command.tint.a);
+
+                // same corners as DrawTexturePro, rotated around dest.x, dest.y
+                const float dx = -command.origin.x;
+                const float dy = -command.origin.y;
+                const float w = command.dest.width;
+                const float h = command.dest.height;
+                const float radians = command.rotation * DEG2RAD;
+                const float c = std::cos(radians);
+                const float s = std::sin(radians);
+                const Vector2 corners[4] = {{dx, dy}, {dx, dy + h}, {dx + w, dy + h}, {dx + w, dy}};
+                const Rectangle &uv = command.uv;
+                const Vector2 uvs[4] = {
+                        {uv.x, uv.y}, {uv.x, uv.y + uv.height}, {uv.x + uv.width, uv.y + uv.height}, {uv.x + uv.width, uv.y}};
+                for (int corner = 0; corner < 4; corner++) {
+                    const Vector2 local = corners[corner];
+                    rlTexCoord2f(uvs[corner].x, uvs[corner].y);
+                    rlVertex2f(command.dest.x + local.x * c - local.y * s, command.dest.y + local.x * s + local.y * c);
+                }
+            }
+            rlEnd();
+        });
+        rlSetTexture(0);
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SPRITE_QUEUE_H
+#define SPRITE_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "components.h"
+
+namespace rendering::sprite_queue {
+    /**
+     * Packs the draw order in a single integer, 16 bits of priority, 16 bits of texture id and the 32 bits of y.
+     * Sorting on it draws lower priorities first, keeps same texture sprites together and layers them top to bottom.
+     */
+    uint64_t sort_key(int priority, unsigned int texture_id, float y);
+
+    // queue the renderable's atlas sprite at the position, with the same placement DrawTexturePro would give it
+    void push(SpriteQueue &queue, const Atlas &atlas, const Renderable &renderable, Vector2 position, float rotation,
+              int priority);
+
+    // stable LSD radix sort of the commands on their key, the bytes every key shares are skipped
+    void sort(SpriteQueue &queue);
+
+    // calls fn(first, count) for every run of consecutive commands sharing a texture
+    template<typename Fn>
+    void for_each_batch(const SpriteQueue &queue, Fn &&fn) {
+        const size_t count = queue.commands.size();
+        size_t start = 0;
+        for (size_t i = 1; i <= count; i++) {
+            if (i == count || queue.commands[i].texture_id != queue.commands[start].texture_id) {
+                fn(&queue.commands[start], i - start);
+                start = i;
+            }
+        }
+    }
+
+    // draws the sorted commands through rlgl, one texture bind per batch, needs an open window. With every sprite in
+    // the atlas that is a single bind per priority
+    void submit(SpriteQueue &queue);
+}
+
+#endif //SPRITE_QUEUE_H
@@ -5,19 +5,51 @@
 #ifndef DETERMINE_VISIBLE_ENTITIES_SYSTEM_H
 #define DETERMINE_VISIBLE_ENTITIES_SYSTEM_H
 
+#include <cstdint>
+#include <vector>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/rendering/components.h"
+
 namespace rendering::systems {
-    inline void determine_visible_entities_system(flecs::entity e, const core::Position2D &pos,
-                                                  const Renderable &renderable,
-                                                  const core::GameSettings &settings,
-                                                  const TrackingCamera& camera) {
-        //if (!camera.target.is_alive()) return;
-        if (pos.value.x - camera.camera.target.x > settings.window_width * 1.05f + renderable.texture.width - camera.camera.offset.x|| pos.value.x - camera.camera.target.x + settings.window_width * 0.05f < -renderable.texture.
-            width - camera.camera.offset.x ||
-            pos.value.y - camera.camera.target.y > settings.window_height * 1.05f + renderable.texture.height - camera.camera.offset.y || pos.value.y - camera.camera.target.y + settings.window_height * 0.05f < -renderable.texture
-            .height - camera.camera.offset.y) {
-            e.remove<Visible>();
-        } else if (!e.has<Visible>()) {
-            e.add<Visible>();
+    // Visible doesn't fragment, so flipping it never moves an entity between tables. The bounds are computed once
+    // per frame and each table is culled in a branch free pass before the tag is touched, only where it changed.
+    inline void determine_visible_entities_system(flecs::iter &it) {
+        const core::GameSettings &settings = it.world().get<core::GameSettings>();
+        const Camera2D &camera = it.world().get<TrackingCamera>().camera;
+        const Atlas &atlas = it.world().get<Atlas>();
+
+        // the view with a 5% margin on each side, in world space
+        const float left = camera.target.x - camera.offset.x - settings.window_width * 0.05f;
+        const float right = camera.target.x - camera.offset.x + settings.window_width * 1.05f;
+        const float top = camera.target.y - camera.offset.y - settings.window_height * 0.05f;
+        const float bottom = camera.target.y - camera.offset.y + settings.window_height * 1.05f;
+
+        std::vector<uint8_t> visible;
+        while (it.next()) {
+            auto pos = it.field<const core::Position2D>(0);
+            auto renderable = it.field<const Renderable>(1);
+            // prefabs share their Renderable, every row of the table then reads the same sprite
+            const bool shared = !it.is_self(1);
+
+            visible.resize(it.count());
+            for (size_t i = 0; i < it.count(); i++) {
+                const Rectangle &sprite = atlas.rects[renderable[shared ? 0 : i].sprite];
+                const float width = sprite.width;
+                const float height = sprite.height;
+                visible[i] = (pos[i].value.x >= left - width) & (pos[i].value.x <= right + width) &
+                             (pos[i].value.y >= top - height) & (pos[i].value.y <= bottom + height);
+            }
+
+            for (size_t i = 0; i < it.count(); i++) {
+                flecs::entity e = it.entity(i);
+                if (visible[i] == e.has<Visible>())
+                    continue;
+                if (visible[i])
+                    e.add<Visible>();
+                else
+                    e.remove<Visible>();
+            }
         }
     }
 }
@@ -0,0 +1,18 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef DRAW_BAR_QUEUE_SYSTEM_H
+#define DRAW_BAR_QUEUE_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/rendering/bar_queue.h"
+#include "modules/engine/rendering/components.h"
+
+namespace rendering::systems {
+    inline void draw_bar_queue_system(const RenderSnapshots &snapshots) {
+        if (snapshots.buffer) bar_queue::submit(snapshots.buffer->front.bars);
+    }
+}
+#endif //DRAW_BAR_QUEUE_SYSTEM_H
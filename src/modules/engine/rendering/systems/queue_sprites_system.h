@@ -0,0 +1,60 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef QUEUE_SPRITES_SYSTEM_H
+#define QUEUE_SPRITES_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/engine/rendering/render_snapshot.h"
+#include "modules/engine/rendering/sprite_queue.h"
+
+namespace rendering::systems {
+    // gathers the visible sprites into the queue and sorts it, nothing is drawn here
+    inline void queue_sprites_system(flecs::iter &it) {
+        SpriteQueue &queue = it.world().get_mut<SpriteQueue>();
+        const Atlas &atlas = it.world().get<Atlas>();
+        queue.commands.clear();
+        // nothing to sample until the page is uploaded
+        if (atlas.texture.id == 0) {
+            while (it.next()) {}
+            return;
+        }
+        while (it.next()) {
+            auto renderable = it.field<const Renderable>(0);
+            auto position = it.field<const core::Position2D>(1);
+            auto rotation = it.field<const Rotation>(2);
+            auto priority = it.field<const Priority>(3);
+            const bool shared_renderable = !it.is_self(0);
+            const bool shared_priority = !it.is_self(3);
+            const bool has_rotation = it.is_set(2);
+
+            for (size_t i = 0; i < it.count(); i++) {
+                float angle = has_rotation ? rotation[it.is_self(2) ? i : 0].angle : 0.0f;
+                sprite_queue::push(queue, atlas, renderable[shared_renderable ? 0 : i], position[i].value, angle,
+                                   priority[shared_priority ? 0 : i].priority);
+            }
+        }
+        sprite_queue::sort(queue);
+    }
+
+    // the queues become the published snapshot and an older one is recycled as the next queues
+    inline void publish_render_snapshot_system(SpriteQueue &sprites, BarQueue &bars,
+                                               const RenderSnapshots &snapshots) {
+        if (snapshots.buffer) render_snapshot::publish(*snapshots.buffer, sprites, bars);
+        bars.commands.clear();
+    }
+
+    // the frame draws the latest snapshot published by then, with the camera of the same step
+    inline void acquire_render_snapshot_system(const RenderSnapshots &snapshots) {
+        if (snapshots.buffer) render_snapshot::acquire(*snapshots.buffer);
+    }
+
+    inline void draw_sprite_queue_system(const RenderSnapshots &snapshots) {
+        if (snapshots.buffer) sprite_queue::submit(snapshots.buffer->front.sprites);
+    }
+}
+#endif //QUEUE_SPRITES_SYSTEM_H
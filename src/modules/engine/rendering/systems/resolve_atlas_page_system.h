@@ -0,0 +1,22 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef RESOLVE_ATLAS_PAGE_SYSTEM_H
+#define RESOLVE_ATLAS_PAGE_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/assets/asset_store.h"
+#include "modules/engine/rendering/components.h"
+
+namespace rendering::systems {
+    // the table is known from the start, the page shows up once the store uploaded it
+    inline void resolve_atlas_page_system(Atlas &atlas, const assets::AssetStore &store) {
+        if (atlas.texture.id != 0) return;
+        const Texture2D *page = assets::get_texture(store, atlas.page);
+        if (page) atlas.texture = *page;
+    }
+}
+
+#endif //RESOLVE_ATLAS_PAGE_SYSTEM_H
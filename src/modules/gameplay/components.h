@@ -2,11 +2,17 @@
 // Created by laure on 3/12/2025.
 //
 
-#include <unordered_set>
 #ifndef GAMEPLAY_COMPONENTS_H
 #define GAMEPLAY_COMPONENTS_H
 
 #include <flecs.h>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "hit_set.h"
+#include "modules/engine/physics/components.h"
 
 namespace gameplay {
 
@@ -26,6 +32,55 @@ namespace gameplay {
     struct Spawner {
         flecs::entity enemy_prefab;
         int difficulty;
+        bool spawn_on_sides;
+    };
+
+    // spawners with this spawn whole waves through the bulk path instead of one enemy per frame
+    struct WaveSpawner {
+        int wave_size;
+        float wave_interval;
+        // most enemies created in a single tick, the rest of a wave carries over
+        int per_tick_budget;
+        float elapsed;
+        int pending;
+    };
+
+    // handle on the spawn system so harnesses can drive the population themselves
+    struct SpawnerSystem {
+        flecs::system system;
+        flecs::system wave_system;
+        flecs::entity tick;
+        float interval;
+    };
+
+    // stand-in for `count` enemies of one prefab merged while far from the camera, its Health is their sum
+    struct Swarm {
+        flecs::entity_t prefab;
+        int count;
+        // spread of the members around the swarm position, they are restored within it
+        float radius;
+        // health when the swarm formed, any damage taken since breaks it up
+        float formed_health;
+    };
+
+    struct SwarmSettings {
+        // far enemies of the same prefab and spawner in a cell this large are considered co-located
+        float cell_size;
+        int min_members;
+    };
+
+    // far enemies gathered by cell between two aggregation passes
+    struct SwarmCandidates {
+        struct Group {
+            std::vector<flecs::entity_t> members;
+            Vector2 position_sum;
+            Vector2 velocity_sum;
+            float health;
+            float max_health;
+        };
+
+        // keyed by (prefab, spawner, cell x, cell y)
+        std::map<std::tuple<flecs::entity_t, flecs::entity_t, long, long>, Group> groups;
     };
 
     struct TakeDamage {
@@ -44,12 +99,15 @@ namespace gameplay {
     struct Attack {
         std::string attack_prefab_name;
         std::string target_tag;
+        // resolved from the names when the attack is set
+        flecs::entity_t attack_prefab;
+        flecs::entity_t split_prefab;
+        flecs::entity_t target;
     };
 
     struct RegenHealth {
         float rate; // per second
     };
-    struct HealthBar {};
 
     struct Experience {
         int level;
@@ -72,16 +130,16 @@ namespace gameplay {
 
     struct Pierce {
         int pierce_count;
-        std::unordered_set<int> hits;
+        HitSet hits;
     };
 
     struct Chain {
         int chain_count;
-        std::unordered_set<int> hits;
+        HitSet hits;
     };
 
     struct Split {
-        std::unordered_set<int> hits;
+        HitSet hits;
     };
 
     struct MultiProj {
@@ -92,6 +150,31 @@ namespace gameplay {
     };
 
 
+    // set on projectiles owned by the pool, they are disabled and recycled instead of destructed
+    struct PooledFrom {
+        flecs::entity_t prefab;
+        flecs::entity_t parent;
+    };
+
+    // on the parents of pooled projectiles, the buckets under a parent are dropped with it
+    struct PoolParent {};
+
+    // on the prefab the split halves are spawned from, the modifier menus leave it without modifiers
+    struct SplitPrefab {};
+
+    struct ProjectilePool {
+        struct Bucket {
+            std::vector<flecs::entity_t> free;
+            size_t active;
+            size_t high_water;
+        };
+
+        // keyed by (prefab, parent)
+        std::unordered_map<std::pair<flecs::entity_t, flecs::entity_t>, Bucket, physics::IdPairHash> buckets;
+        // instances kept ready even before a bucket has a history
+        size_t min_free;
+    };
+
     struct OnDeathEffect {};
     struct GiveExperience {
         flecs::entity other;
@@ -4,6 +4,7 @@
 
 #include "gameplay_module.h"
 #include "components.h"
+#include "modules/ai/components.h"
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
 #include <raymath.h>
@@ -16,14 +17,15 @@
 #include "modules/engine/physics/pipeline_steps.h"
 #include "modules/engine/rendering/gui/gui_module.h"
 #include "modules/engine/rendering/gui/prefabs.h"
+#include "modules/engine/rendering/pipeline_steps.h"
 #include "pipeline_steps.h"
 #include "systems/add_bounce_system.h"
+#include "systems/aggregate_swarms_system.h"
 #include "systems/add_chain_system.h"
 #include "systems/add_multiproj_system.h"
 #include "systems/add_pierce_system.h"
 #include "systems/add_split_system.h"
 #include "systems/check_if_dead_system.h"
-#include "systems/create_health_bar_system.h"
 #include "systems/deal_damage_on_collision_system.h"
 #include "systems/decrement_bounce_system.h"
 #include "systems/decrement_chain_system.h"
@@ -31,6 +33,7 @@
 #include "systems/decrement_pierce_system.h"
 #include "systems/fire_projectile_system.h"
 #include "systems/give_experience_system.h"
+#include "systems/grow_projectile_pools_system.h"
 #include "systems/increment_bounce_system.h"
 #include "systems/increment_chain_system.h"
 #include "systems/increment_multiproj_system.h"
@@ -41,39 +44,89 @@
 #include "systems/projectile_no_effect_collided_system.h"
 #include "systems/projectile_pierce_collided_system.h"
 #include "systems/projectile_split_collision_system.h"
+#include "systems/queue_health_bars_system.h"
 #include "systems/regen_health_system.h"
+#include "systems/release_pooled_projectile_system.h"
 #include "systems/remove_bounce_system.h"
 #include "systems/remove_chain_system.h"
 #include "systems/remove_multproj_system.h"
 #include "systems/remove_pierce_system.h"
 #include "systems/remove_split_system.h"
+#include "systems/resolve_attack_system.h"
 #include "systems/restart_cooldown_system.h"
+#include "systems/schedule_cooldown_system.h"
 #include "systems/spawn_enemies_around_screen_system.h"
+#include "systems/spawn_wave_system.h"
 #include "systems/take_damage_system.h"
-#include "systems/update_cooldown_system.h"
-#include "systems/update_health_bar_system.h"
 
 namespace gameplay {
     void GameplayModule::register_components(flecs::world world) {
         world.component<Spawner>();
+        world.component<SpawnerSystem>().add(flecs::Singleton);
+        world.component<WaveSpawner>();
+        world.component<PooledFrom>();
+        world.component<PoolParent>();
+        world.component<SplitPrefab>().add(flecs::OnInstantiate, flecs::DontInherit);
+        world.component<ProjectilePool>().add(flecs::Singleton);
+        world.set<ProjectilePool>({{}, 16});
+        world.component<Swarm>();
+        world.component<SwarmSettings>().add(flecs::Singleton);
+        world.set<SwarmSettings>({256.0f, 8});
+        world.component<SwarmCandidates>().add(flecs::Singleton);
+        world.add<SwarmCandidates>();
     }
 
     void GameplayModule::register_systems(flecs::world world) {
-        m_spawner_tick = world.timer().interval(spawner_interval);
+        flecs::entity spawner_tick = world.timer().interval(BASE_SPAWNER_INTERVAL);
 
-        spawn_system = world.system<const Spawner, const core::GameSettings, const rendering::TrackingCamera>("Spawn Enemies")
-                //.tick_source(m_spawner_tick)
+        flecs::system spawn_system = world.system<Spawner, const core::GameSettings, const rendering::TrackingCamera, core::Random>("Spawn Enemies")
+                //.tick_source(spawner_tick)
+                .without<WaveSpawner>()
                 .each(systems::spawn_enemies_around_screen_system);
 
-        // world.system<Cooldown>("Update Cooldown")
-        //         .without<CooldownCompleted>()
-        //         .each(systems::update_cooldown_system);
+        // bulk creation cannot run deferred
+        flecs::system wave_system =
+                world.system<Spawner, WaveSpawner, const core::GameSettings, const rendering::TrackingCamera,
+                             core::Random>("Spawn Waves")
+                        .immediate()
+                        .each(systems::spawn_wave_system);
+        world.set<SpawnerSystem>({spawn_system, wave_system, spawner_tick, BASE_SPAWNER_INTERVAL});
+
+        // far clusters are merged once a second, swarms are checked every tick so they break up in time
+        flecs::entity swarm_tick = world.timer().interval(1.0f);
+        world.system<const core::Position2D, const physics::Velocity2D, const Health, const physics::SimulationLod,
+                     SwarmCandidates, const SwarmSettings>("Gather swarm candidates")
+                .with<ai::FollowTarget>()
+                .without<Swarm>()
+                .without<core::DestroyAfterFrame>()
+                .tick_source(swarm_tick)
+                .each(systems::gather_swarm_candidates_system);
+
+        world.system<SwarmCandidates, const SwarmSettings>("Form swarms")
+                .tick_source(swarm_tick)
+                .immediate()
+                .each(systems::form_swarms_system);
+
+        // bulk creation cannot run deferred
+        world.system<const Swarm, const Health, const physics::SimulationLod *, core::Random>("Disband swarms")
+                .without<core::DestroyAfterFrame>()
+                .immediate()
+                .each(systems::disband_swarms_system);
+
+        // world.observer<const Cooldown>("Schedule Cooldown")
+        //         .event(flecs::OnSet)
+        //         .each(systems::schedule_cooldown_system);
         //
         // world.observer("Restart Cooldown")
         //         .with<CooldownCompleted>()
         //         .event(flecs::OnRemove)
         //         .each(systems::restart_cooldown_system);
         //
+        world.observer<Attack>("Resolve attack")
+                .with(flecs::Prefab).optional()
+                .event(flecs::OnSet)
+                .each(systems::resolve_attack_system);
+
         // world.system<core::Position2D, Attack, core::Speed, MultiProj *>("Fire Projectile")
         //         .with<Projectile>()
         //         .with<CooldownCompleted>()
@@ -98,6 +151,25 @@ namespace gameplay {
         //         .immediate()
         //         .each(systems::projectile_bounce_collided_system);
 
+        // dead pooled projectiles are handed back before the core destroys entities tagged DestroyAfterFrame
+        world.observer<const PooledFrom>("Return projectile to pool")
+                .term_at(0).filter()
+                .with<core::DestroyAfterFrame>()
+                .event(flecs::OnAdd)
+                .each(systems::release_pooled_projectile_system);
+
+        // the parent being deleted takes its pooled children with it
+        world.observer("Drop projectile pool buckets")
+                .with<PoolParent>()
+                .with(flecs::Disabled).optional()
+                .event(flecs::OnRemove)
+                .each(systems::drop_projectile_pool_buckets_system);
+
+        world.system<ProjectilePool>("Grow projectile pools")
+                .kind(flecs::OnLoad)
+                .immediate()
+                .each(systems::grow_projectile_pools_system);
+
         world.system("no pierce or chain")
                 .with<Projectile>()
                 .without<Pierce>().without<Chain>()
@@ -136,23 +208,16 @@ namespace gameplay {
         //         .with<physics::CollidedWith>(flecs::Wildcard)
         //         .immediate()
         //         .kind<OnCollisionDetected>()
-        //         .tick_source(physics::m_physicsTick)
+        //         .tick_source(world.get<physics::PhysicsTick>().timer)
         //         .each(systems::deal_damage_on_collision_system);
         //
         // world.system<Damage>("collision detected, deal damage to target (non-frag)")
         //         .with<physics::NonFragmentingCollidedWith>(flecs::Wildcard)
         //         .immediate()
         //         .kind<OnCollisionDetected>()
-        //         .tick_source(physics::m_physicsTick)
+        //         .tick_source(world.get<physics::PhysicsTick>().timer)
         //         .each(systems::deal_damage_on_collision_system);
         //
-        // world.system<const Health>("create health bar")
-        //         .with<TakeDamage>()
-        //         .without<HealthBar>()
-        //         .without<rendering::ProgressBar>()
-        //         .kind<PostCollisionDetected>()
-        //         .each(systems::create_health_bar_system);
-        //
         // world.system<Health, TakeDamage>("take damage")
         //         .kind<PostCollisionDetected>()
         //         .each(systems::take_damage_system);
@@ -163,11 +228,6 @@ namespace gameplay {
         //         .each(systems::check_if_dead_system);
         //
         //
-        // world.system<const Health, rendering::ProgressBar>("update health bar on take damage")
-        //         .kind<PostCollisionDetected>()
-        //         .term_at(0).parent()
-        //         .each(systems::update_health_bar_system);
-        //
         // world.system<Health, RegenHealth>("regen health")
         //         .kind(flecs::OnUpdate)
         //         .each(systems::regen_health_system);
@@ -178,7 +238,14 @@ namespace gameplay {
         //         .kind<PostCollisionDetected>()
         //         .each(systems::give_experience_system);
 
-        add_multiproj = world.system("add multi proj")
+        // no bar entity is kept per enemy, the damaged ones are read off Health every frame and drawn in one batch
+        world.system<const Health, const core::Position2D, const rendering::Renderable, const rendering::Atlas,
+                     rendering::BarQueue>("Queue health bars")
+                .with<rendering::Visible>()
+                .kind<rendering::PrepareRender>()
+                .each(systems::queue_health_bars_system);
+
+        flecs::system add_multiproj = world.system("add multi proj")
                 .kind(0)
                 .with<Attack>()
                 .without<MultiProj>()
@@ -186,7 +253,7 @@ namespace gameplay {
                 .immediate()
                 .each(systems::add_multiproj_system);
 
-        remove_multiproj = world.system("remove multi proj")
+        flecs::system remove_multiproj = world.system("remove multi proj")
                 .kind(0)
                 .with<Attack>()
                 .with<MultiProj>()
@@ -194,110 +261,116 @@ namespace gameplay {
                 .immediate()
                 .each(systems::remove_multiproj_system);
 
-        add_pierce = world.system("add pierce")
+        flecs::system add_pierce = world.system("add pierce")
                 .kind(0)
                 .with<Projectile>()
                 .without<Pierce>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::add_pierce_system(world, e);
                 });
 
-        remove_pierce = world.system("remove pierce")
+        flecs::system remove_pierce = world.system("remove pierce")
                 .kind(0)
                 .with<Projectile>()
                 .with<Pierce>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::remove_pierce_system(world, e);
                 });
 
-        add_chain = world.system("add chain")
+        flecs::system add_chain = world.system("add chain")
                 .kind(0)
                 .with<Projectile>()
                 .without<Chain>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::add_chain_system(world, e);
                 });
 
-        remove_chain = world.system("remove chain")
+        flecs::system remove_chain = world.system("remove chain")
                 .kind(0)
                 .with<Projectile>()
                 .with<Chain>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::remove_chain_system(world, e);
                 });
 
-        add_split = world.system("add split")
+        flecs::system add_split = world.system("add split")
                 .kind(0)
                 .with<Projectile>()
                 .without<Split>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::add_split_system(world, e);
                 });
 
-        remove_split = world.system("remove split")
+        flecs::system remove_split = world.system("remove split")
                 .kind(0)
                 .with<Projectile>()
                 .with<Split>()
                 .with(flecs::Prefab)
+                .without<SplitPrefab>()
                 .immediate()
                 .each([world](flecs::entity e) {
                     systems::remove_split_system(world, e);
                 });
 
-        add_proj = world.system<MultiProj>("+1 proj")
+        flecs::system add_proj = world.system<MultiProj>("+1 proj")
                 .kind(0)
                 .with<Attack>()
                 .with(flecs::ChildOf, "player")
                 .each(systems::increment_multiproj_system);
 
-        remove_proj = world.system<MultiProj>("-1 proj")
+        flecs::system remove_proj = world.system<MultiProj>("-1 proj")
                 .kind(0)
                 .with<Attack>()
                 .with(flecs::ChildOf, "player")
                 .each(systems::decrement_multiproj_system);
 
-        add_pierce_amt = world.system<Pierce>("+1 Pierce")
+        flecs::system add_pierce_amt = world.system<Pierce>("+1 Pierce")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .each(systems::increment_pierce_system);
 
-        remove_pierce_amt = world.system<Pierce>("-1 Pierce")
+        flecs::system remove_pierce_amt = world.system<Pierce>("-1 Pierce")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .each(systems::decrement_pierce_system);
 
-        add_chain_amt = world.system<Chain>("+1 Chain")
+        flecs::system add_chain_amt = world.system<Chain>("+1 Chain")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .each(systems::increment_chain_system);
 
-        remove_chain_amt = world.system<Chain>("-1 Chain")
+        flecs::system remove_chain_amt = world.system<Chain>("-1 Chain")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .each(systems::decrement_chain_system);
 
-        add_bounce = world.system("add bounce")
+        flecs::system add_bounce = world.system("add bounce")
                 .kind(0)
                 .with<Projectile>()
                 .without<Bounce>()
                 .with(flecs::Prefab)
                 .immediate()
                 .each(systems::add_bounce_system);
-        remove_bounce = world.system("remove bounce")
+        flecs::system remove_bounce = world.system("remove bounce")
                 .kind(0)
                 .with<Projectile>()
                 .with<Bounce>()
@@ -305,22 +378,21 @@ namespace gameplay {
                 .immediate()
                 .each(systems::remove_bounce_system);
 
-        add_bounce_amt = world.system<Bounce>("+1 Bounce")
+        flecs::system add_bounce_amt = world.system<Bounce>("+1 Bounce")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .immediate()
                 .each(systems::increment_bounce_system);
 
-        remove_bounce_amt = world.system<Bounce>("-1 Bounce")
+        flecs::system remove_bounce_amt = world.system<Bounce>("-1 Bounce")
                 .kind(0)
                 .with<Projectile>()
                 .with(flecs::Prefab)
                 .immediate()
                 .each(systems::decrement_bounce_system);
-    }
 
-    void GameplayModule::register_entities(flecs::world world) {
+        // the menu items hold the systems above, so they are created here rather than in register_entities
         auto dropdown = world.entity("gameplay_dropdown").child_of<rendering::gui::prefabs::MenuBar>()
                 .set<rendering::gui::MenuBarTab>({"Gameplay Tools", 25});
 
@@ -10,35 +10,12 @@
 
 namespace gameplay {
     const float BASE_SPAWNER_INTERVAL = 0.01f;
-    inline float spawner_interval = BASE_SPAWNER_INTERVAL;
-    inline flecs::system add_multiproj;
-    inline flecs::system remove_multiproj;
-    inline flecs::system add_pierce;
-    inline flecs::system remove_pierce;
-    inline flecs::system add_chain;
-    inline flecs::system remove_chain;
-    inline flecs::system add_split;
-    inline flecs::system remove_split;
-    inline flecs::system add_proj;
-    inline flecs::system remove_proj;
-    inline flecs::system add_pierce_amt;
-    inline flecs::system remove_pierce_amt;
-    inline flecs::system add_chain_amt;
-    inline flecs::system remove_chain_amt;
-
-    inline flecs::system add_bounce;
-    inline flecs::system remove_bounce;
-    inline flecs::system add_bounce_amt;
-    inline flecs::system remove_bounce_amt;
-    inline flecs::system spawn_system;
-    inline flecs::entity m_spawner_tick;
 
     class GameplayModule : public BaseModule<GameplayModule> {
     public:
         GameplayModule(flecs::world &world): BaseModule(world) {
         }
         ~GameplayModule() {
-            //m_spawner_tick.destruct();
         }
 
 
@@ -48,8 +25,6 @@ namespace gameplay {
 
         void register_systems(flecs::world);
 
-        void register_entities(flecs::world);
-
         void register_pipeline(flecs::world);
 
         friend class BaseModule<GameplayModule>;
@@ -0,0 +1,69 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef HIT_SET_H
+#define HIT_SET_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <flecs.h>
+
+namespace gameplay {
+    /**
+     * Flat set of the entities a projectile already hit. Projectiles rarely hit more than a handful of targets,
+     * so the first INLINE_CAPACITY ids live in the component itself and only the ones after that spill to a sorted
+     * heap block. Copies of an empty or inline set (prefab overrides, pool resets) never allocate. The spill
+     * allocator is only swapped by the benchmark to count the heap requests.
+     */
+    template<typename Allocator = std::allocator<flecs::entity_t>>
+    class BasicHitSet {
+    public:
+        static constexpr size_t INLINE_CAPACITY = 8;
+
+        [[nodiscard]] bool contains(flecs::entity_t id) const {
+            size_t count = std::min<size_t>(m_size, INLINE_CAPACITY);
+            for (size_t i = 0; i < count; i++) {
+                if (m_inline[i] == id) return true;
+            }
+            return !m_spill.empty() && std::binary_search(m_spill.begin(), m_spill.end(), id);
+        }
+
+        // returns false when the id was already in the set
+        bool insert(flecs::entity_t id) {
+            if (contains(id)) return false;
+            if (m_size < INLINE_CAPACITY) {
+                m_inline[m_size] = id;
+            } else {
+                m_spill.insert(std::lower_bound(m_spill.begin(), m_spill.end(), id), id);
+            }
+            m_size++;
+            return true;
+        }
+
+        void clear() {
+            m_size = 0;
+            m_spill.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+        [[nodiscard]] bool spilled() const { return m_size > INLINE_CAPACITY; }
+
+        // bytes owned outside of the component
+        [[nodiscard]] size_t heap_bytes() const { return m_spill.capacity() * sizeof(flecs::entity_t); }
+
+    private:
+        std::array<flecs::entity_t, INLINE_CAPACITY> m_inline{};
+        uint32_t m_size = 0;
+        std::vector<flecs::entity_t, Allocator> m_spill;
+    };
+
+    using HitSet = BasicHitSet<>;
+}
+
+#endif //HIT_SET_H
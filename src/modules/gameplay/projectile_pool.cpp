@@ -0,0 +1,169 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "projectile_pool.h"
+
+#include <algorithm>
+
+#include "modules/engine/core/timing_wheel.h"
+
+namespace gameplay::pool {
+    // only what the prefab owns, a split prefab leaves the modifiers of its base out
+    template<typename T>
+    static void reset_from_prefab(flecs::entity e, flecs::entity prefab) {
+        if (prefab.owns<T>()) {
+            e.set<T>(prefab.get<T>());
+        } else {
+            e.remove<T>();
+        }
+    }
+
+    template<typename T>
+    static void drop_unless_owned(flecs::entity e, flecs::entity prefab) {
+        if (!prefab.owns<T>()) e.remove<T>();
+    }
+
+    // instantiating copies the modifiers of every base, the ones a derived prefab took off are dropped again.
+    // Removes are queued like the instantiation when deferred, so the entity isn't checked
+    static void drop_base_modifiers(flecs::entity e, flecs::entity prefab) {
+        if (!prefab.target(flecs::IsA)) return;
+        drop_unless_owned<Pierce>(e, prefab);
+        drop_unless_owned<Chain>(e, prefab);
+        drop_unless_owned<Split>(e, prefab);
+        drop_unless_owned<Bounce>(e, prefab);
+    }
+
+    // the value instances get, looked up through the bases since a derived prefab doesn't have to own it
+    template<typename T>
+    static const T *instantiated_value(flecs::entity prefab) {
+        for (; prefab; prefab = prefab.target(flecs::IsA))
+            if (const T *value = prefab.try_get<T>()) return value;
+        return nullptr;
+    }
+
+    void prewarm(flecs::world world, flecs::entity prefab, flecs::entity parent, size_t count) {
+        ProjectilePool &pool = world.get_mut<ProjectilePool>();
+        ProjectilePool::Bucket &bucket = pool.buckets[{prefab, parent}];
+        if (bucket.free.size() >= count) return;
+        parent.add<PoolParent>();
+
+        size_t missing = count - bucket.free.size();
+        std::vector<PooledFrom> pooled(missing, {prefab, parent});
+        void *data[] = {nullptr, nullptr, nullptr, pooled.data()};
+
+        ecs_bulk_desc_t desc = {};
+        desc.ids[0] = ecs_isa(prefab);
+        desc.ids[1] = ecs_childof(parent);
+        desc.ids[2] = flecs::Disabled;
+        desc.ids[3] = world.id<PooledFrom>();
+        desc.count = static_cast<int32_t>(missing);
+        desc.data = data;
+        const flecs::entity_t *entities = ecs_bulk_init(world, &desc);
+
+        // instantiating copies the prefab lifetime, which schedules a destroy on entities that are not live yet
+        core::TimingWheel &wheel = world.get_mut<core::TimingWheel>();
+        for (size_t i = 0; i < missing; i++) {
+            wheel.cancel(entities[i], world.id<core::DestroyAfterFrame>());
+            drop_base_modifiers(flecs::entity(world, entities[i]), prefab);
+            bucket.free.push_back(entities[i]);
+        }
+    }
+
+    // the spawn columns of a table, null where the table doesn't have one
+    struct SpawnColumns {
+        ecs_table_t *table = nullptr;
+        core::Position2D *positions = nullptr;
+        rendering::Rotation *rotations = nullptr;
+        physics::Velocity2D *velocities = nullptr;
+        core::Speed *speeds = nullptr;
+    };
+
+    static SpawnColumns spawn_columns(flecs::world world, ecs_table_t *table) {
+        return {table,
+                static_cast<core::Position2D *>(ecs_table_get_id(world, table, world.id<core::Position2D>(), 0)),
+                static_cast<rendering::Rotation *>(ecs_table_get_id(world, table, world.id<rendering::Rotation>(), 0)),
+                static_cast<physics::Velocity2D *>(ecs_table_get_id(world, table, world.id<physics::Velocity2D>(), 0)),
+                static_cast<core::Speed *>(ecs_table_get_id(world, table, world.id<core::Speed>(), 0))};
+    }
+
+    static void set_spawn(flecs::entity e, const ProjectileSpawn &s) {
+        e.set<core::Position2D>(s.position)
+                .set<rendering::Rotation>(s.rotation)
+                .set<physics::Velocity2D>(s.velocity)
+                .set<core::Speed>(s.speed);
+    }
+
+    void spawn(flecs::world world, flecs::entity prefab, flecs::entity parent, const ProjectileSpawn *spawns,
+               size_t count) {
+        ProjectilePool &pool = world.get_mut<ProjectilePool>();
+        ProjectilePool::Bucket &bucket = pool.buckets[{prefab, parent}];
+        const core::DestroyAfterTime *lifetime = instantiated_value<core::DestroyAfterTime>(prefab);
+        if (!parent.has<PoolParent>()) parent.add<PoolParent>();
+
+        // pooled entities are written in place, the columns are looked up once per table for the whole batch. Nothing
+        // moves while writing, the entities are only enabled afterwards
+        const size_t pooled = std::min(count, bucket.free.size());
+        const flecs::entity_t *taken = bucket.free.data() + bucket.free.size() - pooled;
+        SpawnColumns columns;
+        for (size_t i = 0; i < pooled; i++) {
+            const ProjectileSpawn &s = spawns[i];
+            ecs_record_t *record = ecs_record_find(world, taken[i]);
+            if (record->table != columns.table) columns = spawn_columns(world, record->table);
+            if (columns.positions && columns.rotations && columns.velocities && columns.speeds) {
+                const int32_t row = ECS_RECORD_TO_ROW(record->row);
+                columns.positions[row] = s.position;
+                columns.rotations[row] = s.rotation;
+                columns.velocities[row] = s.velocity;
+                columns.speeds[row] = s.speed;
+            } else {
+                // the prefab lacks one of them, adding it moves the entity out of the table
+                set_spawn(flecs::entity(world, taken[i]), s);
+                columns = {};
+            }
+        }
+
+        // the Disabled tag is the only structural change, merged into a single table move when deferred. The lifetime
+        // is still set per entity, its OnSet observer schedules the destroy on the timing wheel
+        for (size_t i = 0; i < pooled; i++) {
+            flecs::entity e(world, taken[i]);
+            e.enable();
+            // restart the lifetime, pooled entities keep the one of their previous life
+            if (lifetime) e.set<core::DestroyAfterTime>(*lifetime);
+        }
+        bucket.free.resize(bucket.free.size() - pooled);
+
+        for (size_t i = pooled; i < count; i++) {
+            flecs::entity e = world.entity().is_a(prefab).child_of(parent).set<PooledFrom>({prefab, parent});
+            drop_base_modifiers(e, prefab);
+            set_spawn(e, spawns[i]);
+        }
+
+        bucket.active += count;
+        bucket.high_water = std::max(bucket.high_water, bucket.active);
+    }
+
+    void release(flecs::entity e, const PooledFrom &pooled) {
+        flecs::world world = e.world();
+        flecs::entity prefab(world, pooled.prefab);
+
+        e.remove<core::DestroyAfterFrame>();
+        e.remove<physics::CollidedWith>(flecs::Wildcard);
+        e.remove<physics::NonFragmentingCollidedWith>(flecs::Wildcard);
+        reset_from_prefab<Pierce>(e, prefab);
+        reset_from_prefab<Chain>(e, prefab);
+        reset_from_prefab<Split>(e, prefab);
+        reset_from_prefab<Bounce>(e, prefab);
+        world.get_mut<core::TimingWheel>().cancel(e, world.id<core::DestroyAfterFrame>());
+        e.disable();
+
+        ProjectilePool::Bucket &bucket = world.get_mut<ProjectilePool>().buckets[{pooled.prefab, pooled.parent}];
+        bucket.active = bucket.active > 0 ? bucket.active - 1 : 0;
+        bucket.free.push_back(e);
+    }
+
+    void drop_buckets(flecs::world world, flecs::entity parent) {
+        std::erase_if(world.get_mut<ProjectilePool>().buckets,
+                      [&](const auto &bucket) { return bucket.first.second == parent.id(); });
+    }
+}
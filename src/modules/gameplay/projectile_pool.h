@@ -0,0 +1,47 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+
+#include <flecs.h>
+
+#include "components.h"
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/engine/rendering/components.h"
+
+namespace gameplay::pool {
+    struct ProjectileSpawn {
+        core::Position2D position;
+        rendering::Rotation rotation;
+        physics::Velocity2D velocity;
+        core::Speed speed;
+    };
+
+    /**
+     * Create disabled instances of the prefab under the parent with a single bulk init until the bucket has
+     * `count` free entities. The world must not be deferred.
+     */
+    void prewarm(flecs::world world, flecs::entity prefab, flecs::entity parent, size_t count);
+
+    /**
+     * Activate a pooled instance per spawn. Their columns are written in place, looked up once per table for the
+     * batch, then their Disabled tag is removed: when called from a deferred system that is a single table move
+     * each. An empty bucket falls back to instantiating the prefab, the new entity joins the pool when it dies.
+     */
+    void spawn(flecs::world world, flecs::entity prefab, flecs::entity parent, const ProjectileSpawn *spawns,
+               size_t count);
+
+    /**
+     * Put an entity back in its bucket: its collisions are dropped, the modifiers it lost or gained are reset
+     * from the prefab and it is disabled.
+     */
+    void release(flecs::entity e, const PooledFrom &pooled);
+
+    // forget the buckets of a parent being deleted, their free lists only hold its dead children
+    void drop_buckets(flecs::world world, flecs::entity parent);
+}
+
+#endif //PROJECTILE_POOL_H
@@ -0,0 +1,95 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "swarms.h"
+
+#include <cmath>
+#include <random>
+
+#include <raymath.h>
+
+#include "modules/ai/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/engine/physics/physics_module.h"
+#include "wave_spawner.h"
+
+namespace gameplay::swarms {
+    int form(flecs::world world, SwarmCandidates &candidates, const SwarmSettings &settings) {
+        int merged = 0;
+        for (auto &[key, group]: candidates.groups) {
+            const int count = static_cast<int>(group.members.size());
+            if (count < settings.min_members) continue;
+
+            flecs::entity prefab(world, std::get<0>(key));
+            flecs::entity spawner(world, std::get<1>(key));
+            Vector2 position = group.position_sum / static_cast<float>(count);
+            Vector2 velocity = group.velocity_sum / static_cast<float>(count);
+
+            float spread = 0.0f;
+            for (flecs::entity_t member: group.members) {
+                flecs::entity e(world, member);
+                spread += Vector2DistanceSqr(e.get<core::Position2D>().value, position);
+                e.add<core::DestroyAfterFrame>();
+            }
+            spread = std::max(std::sqrt(spread / count), settings.cell_size / 4.0f);
+
+            flecs::entity swarm = world.entity()
+                                          .child_of(spawner)
+                                          .set<Swarm>({prefab, count, spread, group.health})
+                                          .set<core::Position2D>({position})
+                                          .set<physics::Velocity2D>({velocity})
+                                          .set<physics::DesiredVelocity2D>({velocity})
+                                          .set<Health>({group.max_health, group.health});
+            if (const auto *speed = prefab.try_get<core::Speed>()) swarm.set<core::Speed>(*speed);
+            if (const auto *acceleration = prefab.try_get<physics::AccelerationSpeed>())
+                swarm.set<physics::AccelerationSpeed>(*acceleration);
+            if (flecs::entity target = prefab.target<ai::Target>()) {
+                swarm.add<ai::Target>(target).add<ai::FollowTarget>();
+            }
+            // one circle over the whole spread, hits on it are what break the swarm up
+            physics::Collider collider{true,
+                                       false,
+                                       {-spread, -spread, 2 * spread, 2 * spread},
+                                       physics::CollisionFilter::enemy,
+                                       physics::enemy_filter,
+                                       physics::ColliderType::Circle};
+            if (const auto *prefab_collider = prefab.try_get<physics::Collider>()) {
+                collider.collision_type = prefab_collider->collision_type;
+                collider.collision_filter = prefab_collider->collision_filter;
+            }
+            swarm.set<physics::Collider>(collider).set<physics::CircleCollider>({spread});
+            merged += count;
+        }
+        candidates.groups.clear();
+        return merged;
+    }
+
+    void disband(flecs::world world, flecs::entity swarm, core::Random &random) {
+        const Swarm &data = swarm.get<Swarm>();
+        const Vector2 center = swarm.get<core::Position2D>().value;
+        const Vector2 velocity = swarm.get<physics::Velocity2D>().value;
+        const Health &health = swarm.get<Health>();
+        flecs::entity prefab(world, data.prefab);
+
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<core::Position2D> positions(data.count);
+        for (auto &position: positions) {
+            float r = data.radius * std::sqrt(unit(random.engine));
+            float angle = unit(random.engine) * 2.0f * PI;
+            position.value = center + Vector2{std::cos(angle) * r, std::sin(angle) * r};
+        }
+
+        std::vector<flecs::entity_t> members = waves::bulk_spawn(world, prefab, swarm.parent(), positions);
+        const Health *member_health = prefab.try_get<Health>();
+        float health_ratio = health.max > 0.0f ? health.value / health.max : 1.0f;
+        for (flecs::entity_t member: members) {
+            flecs::entity e(world, member);
+            e.set<physics::Velocity2D>({velocity});
+            if (member_health && health_ratio < 1.0f)
+                e.set<Health>({member_health->max, member_health->max * health_ratio});
+        }
+
+        swarm.add<core::DestroyAfterFrame>();
+    }
+}
@@ -0,0 +1,28 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SWARMS_H
+#define SWARMS_H
+
+#include <flecs.h>
+
+#include "components.h"
+#include "modules/engine/core/components.h"
+
+namespace gameplay::swarms {
+    /**
+     * Replace every gathered group of at least min_members enemies by one swarm entity carrying their mean
+     * position and velocity, count and summed health. The members are tagged DestroyAfterFrame.
+     * @return the number of enemies merged
+     */
+    int form(flecs::world world, SwarmCandidates &candidates, const SwarmSettings &settings);
+
+    /**
+     * Bring the members of a swarm back, spread uniformly over its radius and sharing its velocity and the
+     * remaining fraction of its health. The world must not be deferred.
+     */
+    void disband(flecs::world world, flecs::entity swarm, core::Random &random);
+}
+
+#endif //SWARMS_H
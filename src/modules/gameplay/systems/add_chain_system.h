@@ -12,7 +12,7 @@
 namespace gameplay::systems {
     inline void add_chain_system(const flecs::world& world, flecs::entity e) {
         e.remove<Pierce>();
-        e.set<Chain>({1, std::unordered_set<int>()});
+        e.set<Chain>({1, {}});
         core::systems::remove_empty_tables_system(world);
     }
 }
@@ -12,7 +12,7 @@
 namespace gameplay::systems {
     inline void add_pierce_system(const flecs::world& world, flecs::entity e) {
         e.remove<Chain>();
-        e.set<Pierce>({1, std::unordered_set<int>()});
+        e.set<Pierce>({1, {}});
         core::systems::remove_empty_tables_system(world);
     }
 }
@@ -10,7 +10,7 @@
 
 namespace gameplay::systems {
     inline void add_split_system(const flecs::world& world, flecs::entity e) {
-        e.set<Split>({std::unordered_set<int>()});
+        e.set<Split>({{}});
         core::systems::remove_empty_tables_system(world);
     }
 }
@@ -0,0 +1,52 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef AGGREGATE_SWARMS_SYSTEM_H
+#define AGGREGATE_SWARMS_SYSTEM_H
+
+#include <cmath>
+
+#include <flecs.h>
+#include <raymath.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/gameplay/components.h"
+#include "modules/gameplay/swarms.h"
+
+namespace gameplay::systems {
+    // only enemies at the coarsest level are candidates, the closer ones stay individual
+    inline void gather_swarm_candidates_system(flecs::entity e, const core::Position2D &pos,
+                                               const physics::Velocity2D &vel, const Health &health,
+                                               const physics::SimulationLod &lod, SwarmCandidates &candidates,
+                                               const SwarmSettings &settings) {
+        if (lod.level < 2) return;
+        flecs::entity prefab = e.target(flecs::IsA);
+        flecs::entity spawner = e.parent();
+        if (!prefab || !spawner) return;
+
+        auto &group = candidates.groups[{prefab, spawner,
+                                         static_cast<long>(std::floor(pos.value.x / settings.cell_size)),
+                                         static_cast<long>(std::floor(pos.value.y / settings.cell_size))}];
+        group.members.push_back(e);
+        group.position_sum += pos.value;
+        group.velocity_sum += vel.value;
+        group.health += health.value;
+        group.max_health += health.max;
+    }
+
+    inline void form_swarms_system(flecs::iter &it, size_t, SwarmCandidates &candidates,
+                                   const SwarmSettings &settings) {
+        swarms::form(it.world(), candidates, settings);
+    }
+
+    // swarms break up once they come back within the finer levels or get hurt
+    inline void disband_swarms_system(flecs::iter &it, size_t i, const Swarm &swarm, const Health &health,
+                                      const physics::SimulationLod *lod, core::Random &random) {
+        if ((lod && lod->level < 2) || health.value < swarm.formed_health) {
+            swarms::disband(it.world(), it.entity(i), random);
+        }
+    }
+}
+#endif //AGGREGATE_SWARMS_SYSTEM_H
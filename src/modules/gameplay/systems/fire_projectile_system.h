@@ -10,18 +10,20 @@
 #include <raylib.h>
 #include <raymath.h>
 #include "modules/engine/core/components.h"
-#include "modules/engine/core/queries.h"
+#include "modules/engine/core/tags.h"
 #include "modules/engine/physics/components.h"
 #include "modules/engine/rendering/components.h"
 #include "modules/gameplay/components.h"
+#include "modules/gameplay/projectile_pool.h"
 
 namespace gameplay::systems {
     inline void fire_projectile_system(flecs::iter &iter, size_t index, core::Position2D &pos, Attack &attack,
                                        core::Speed &speed, MultiProj *multi_proj) {
         float shortest_distance_sqr = 1000000;
         core::Position2D target_pos = pos;
-        core::queries::position_and_tag_query.each([&](core::Position2D &o_pos, core::Tag &t) {
-            if (attack.target_tag != t.name) return;
+        const auto *targets = core::tags::positions(iter.world(), attack.target);
+        if (!targets) return;
+        targets->each([&](const core::Position2D &o_pos) {
             float d = Vector2DistanceSqr(pos.value, o_pos.value);
             if (d > shortest_distance_sqr) return;
             shortest_distance_sqr = d;
@@ -38,18 +40,20 @@ namespace gameplay::systems {
         float offset = proj_count % 2 == 0 ? spread_angle / proj_count / 2 : 0;
 
 
-        auto prefab = iter.world().lookup(attack.attack_prefab_name.c_str());
+        flecs::entity prefab(iter.world(), attack.attack_prefab);
 
+        std::vector<pool::ProjectileSpawn> spawns;
+        spawns.reserve(proj_count);
         for (int i = -proj_count / 2; i < (proj_count + 1) / 2; i++) {
             float angle = i * (spread_angle / proj_count) + offset;
-            iter.world().entity().is_a(prefab).child_of(iter.entity(index))
-                    .set<core::Position2D>({pos.value})
-                    .set<rendering::Rotation>({rot + angle})
-                    .set<core::Speed>({150})
-                    .set<physics::Velocity2D>({
-                        Vector2Rotate(Vector2Normalize(target_pos.value - pos.value) * speed.value, angle * DEG2RAD)
-                    });
+            spawns.push_back({
+                {pos.value},
+                {rot + angle},
+                {Vector2Rotate(Vector2Normalize(target_pos.value - pos.value) * speed.value, angle * DEG2RAD)},
+                {150}
+            });
         }
+        pool::spawn(iter.world(), prefab, iter.entity(index), spawns.data(), spawns.size());
         iter.entity(index).remove<CooldownCompleted>();
     }
 }
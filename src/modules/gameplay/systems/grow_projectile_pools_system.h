@@ -0,0 +1,27 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef GROW_PROJECTILE_POOLS_SYSTEM_H
+#define GROW_PROJECTILE_POOLS_SYSTEM_H
+
+#include <algorithm>
+#include <flecs.h>
+
+#include "modules/gameplay/components.h"
+#include "modules/gameplay/projectile_pool.h"
+
+namespace gameplay::systems {
+    // keep enough free instances to reach the previous peak again without creating entities mid-frame
+    inline void grow_projectile_pools_system(flecs::iter &it, size_t i, ProjectilePool &pool) {
+        for (auto &[key, bucket]: pool.buckets) {
+            size_t target = std::max(pool.min_free, bucket.high_water - bucket.active);
+            if (bucket.free.size() >= target) continue;
+            if (!it.world().is_alive(key.first) || !it.world().is_alive(key.second)) continue;
+
+            pool::prewarm(it.world(), flecs::entity(it.world(), key.first), flecs::entity(it.world(), key.second),
+                          target);
+        }
+    }
+}
+#endif //GROW_PROJECTILE_POOLS_SYSTEM_H
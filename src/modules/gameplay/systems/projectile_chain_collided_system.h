@@ -12,9 +12,7 @@
 #include "modules/gameplay/components.h"
 #include <raymath.h>
 
-//#include "modules/engine/core/queries.h"
-#include "modules/engine/core/core_module.h"
-#include "modules/engine/core/queries.h"
+#include "modules/engine/core/tags.h"
 
 namespace gameplay::systems {
     inline void projectile_chain_collided_system(flecs::iter &it, size_t i,
@@ -22,24 +20,26 @@ namespace gameplay::systems {
                                                  core::Position2D &pos, rendering::Rotation &rot, Attack &attack) {
         flecs::entity other = it.pair(5).second();
 
-        if (chain.hits.contains(other.id())) {
+        if (!chain.hits.insert(other.id())) {
             it.entity(i).remove<physics::CollidedWith>(other);
             return;
         }
-        chain.hits.insert(other.id());
         chain.chain_count -= 1;
 
         float shortest_distance_sqr = 1000000;
         core::Position2D target_pos = pos;
-        core::queries::position_and_tag_query.each([&](flecs::entity o, core::Position2D &o_pos, core::Tag &t) {
-            if (!chain.hits.contains(o.id()) && attack.target_tag == t.name && other.id() != o.id()) {
-                float d = Vector2DistanceSqr(pos.value, o_pos.value);
-                if (d < shortest_distance_sqr) {
-                    shortest_distance_sqr = d;
-                    target_pos = o_pos;
+        const auto *targets = core::tags::positions(it.world(), attack.target);
+        if (targets) {
+            targets->each([&](flecs::entity o, const core::Position2D &o_pos) {
+                if (!chain.hits.contains(o.id()) && other.id() != o.id()) {
+                    float d = Vector2DistanceSqr(pos.value, o_pos.value);
+                    if (d < shortest_distance_sqr) {
+                        shortest_distance_sqr = d;
+                        target_pos = o_pos;
+                    }
                 }
-            }
-        });
+            });
+        }
 
         if (target_pos.value == pos.value) return;
 
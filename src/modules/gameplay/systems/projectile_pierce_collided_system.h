@@ -14,11 +14,10 @@
 namespace gameplay::systems {
     inline void projectile_pierce_collided_system(flecs::iter &it, size_t i, Pierce &pierce) {
         flecs::entity other = it.pair(1).second();
-        if (pierce.hits.contains(other.id())) {
+        if (!pierce.hits.insert(other.id())) {
             it.entity(i).remove<physics::CollidedWith>(other);
             return;
         }
-        pierce.hits.insert(other.id());
         pierce.pierce_count -= 1;
         if (pierce.pierce_count < 0) {
             it.entity(i).add<core::DestroyAfterFrame>();
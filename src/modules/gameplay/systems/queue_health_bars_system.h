@@ -0,0 +1,35 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef QUEUE_HEALTH_BARS_SYSTEM_H
+#define QUEUE_HEALTH_BARS_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/rendering/bar_queue.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/gameplay/components.h"
+
+namespace gameplay::systems {
+    constexpr float HEALTH_BAR_WIDTH = 50.0f;
+    constexpr float HEALTH_BAR_HEIGHT = 10.0f;
+
+    // a bar over every damaged visible entity, straight from its Health, nothing is kept between frames
+    inline void queue_health_bars_system(const Health &health, const core::Position2D &pos,
+                                         const rendering::Renderable &renderable, const rendering::Atlas &atlas,
+                                         rendering::BarQueue &queue) {
+        if (health.max - health.value <= 0.05f) return;
+        const float sprite_top = pos.value.y - atlas.rects[renderable.sprite].height / 2.0f * renderable.scale;
+        rendering::bar_queue::push(queue,
+                                   {
+                                       pos.value.x - HEALTH_BAR_WIDTH / 2.0f,
+                                       sprite_top - HEALTH_BAR_HEIGHT,
+                                       HEALTH_BAR_WIDTH,
+                                       HEALTH_BAR_HEIGHT
+                                   },
+                                   health.value / health.max, ColorAlpha(BLACK, 0.6f), RED);
+    }
+}
+#endif //QUEUE_HEALTH_BARS_SYSTEM_H
@@ -0,0 +1,22 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef RELEASE_POOLED_PROJECTILE_SYSTEM_H
+#define RELEASE_POOLED_PROJECTILE_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/gameplay/components.h"
+#include "modules/gameplay/projectile_pool.h"
+
+namespace gameplay::systems {
+    inline void release_pooled_projectile_system(flecs::entity e, const PooledFrom &pooled) {
+        pool::release(e, pooled);
+    }
+
+    inline void drop_projectile_pool_buckets_system(flecs::entity e) {
+        pool::drop_buckets(e.world(), e);
+    }
+}
+#endif //RELEASE_POOLED_PROJECTILE_SYSTEM_H
@@ -0,0 +1,36 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef RESOLVE_ATTACK_SYSTEM_H
+#define RESOLVE_ATTACK_SYSTEM_H
+
+#include <flecs.h>
+
+#include "modules/engine/core/tags.h"
+#include "modules/gameplay/components.h"
+
+namespace gameplay::systems {
+    // names are resolved once when the attack is set, firing and splitting only read the handles
+    inline void resolve_attack_system(flecs::entity e, Attack &attack) {
+        flecs::world world = e.world();
+        attack.target = core::tags::intern(world, attack.target_tag);
+
+        flecs::entity prefab = world.lookup(attack.attack_prefab_name.c_str());
+        attack.attack_prefab = prefab;
+        if (!prefab) {
+            attack.split_prefab = 0;
+            return;
+        }
+
+        // the split halves derive the attack prefab so they follow its later edits, without its modifiers so they
+        // don't split again. The instances still get them through the IsA, the pool takes them off
+        flecs::entity split_prefab = world.lookup((attack.attack_prefab_name + "_split").c_str());
+        if (!split_prefab) {
+            split_prefab = world.prefab((attack.attack_prefab_name + "_split").c_str()).is_a(prefab).add<SplitPrefab>();
+            split_prefab.remove<Split>().remove<Chain>().remove<Pierce>().remove<Bounce>();
+        }
+        attack.split_prefab = split_prefab;
+    }
+}
+#endif //RESOLVE_ATTACK_SYSTEM_H
@@ -7,11 +7,12 @@
 #include <flecs.h>
 
 #include "modules/gameplay/components.h"
+#include "schedule_cooldown_system.h"
 
 namespace gameplay::systems {
     inline void restart_cooldown_system(flecs::entity e) {
         if (e.has<Cooldown>())
-            e.set<Cooldown>({e.get<Cooldown>().value, 0.0f});
+            schedule_cooldown_system(e, e.get<Cooldown>());
     }
 }
 #endif //RESTART_COOLDOWN_SYSTEM_H
@@ -0,0 +1,19 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SCHEDULE_COOLDOWN_SYSTEM_H
+#define SCHEDULE_COOLDOWN_SYSTEM_H
+#include <flecs.h>
+
+#include "modules/engine/core/timing_wheel.h"
+#include "modules/gameplay/components.h"
+
+namespace gameplay::systems {
+    inline void schedule_cooldown_system(flecs::entity e, const Cooldown &cooldown) {
+        e.world().get_mut<core::TimingWheel>().schedule(e, e.world().id<CooldownCompleted>(),
+                                                        core::TimingWheel::ticks(cooldown.value));
+    }
+}
+
+#endif //SCHEDULE_COOLDOWN_SYSTEM_H
@@ -6,26 +6,29 @@
 #define SPAWN_ENEMIES_AROUND_SCREEN_SYSTEM_H
 
 #include <flecs.h>
+#include <random>
+
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/queries.h"
 #include "modules/gameplay/components.h"
 
 namespace gameplay::systems {
-    inline bool outside_side_switch = false;
-
-    inline void spawn_enemies_around_screen_system(flecs::iter &iter, size_t i, const Spawner &spawner,
+    inline void spawn_enemies_around_screen_system(flecs::iter &iter, size_t i, Spawner &spawner,
                                                    const core::GameSettings &settings,
-                                                   const rendering::TrackingCamera &camera) {
+                                                   const rendering::TrackingCamera &camera, core::Random &random) {
         if(iter.world().get<core::Paused>().paused) return;
+        std::uniform_int_distribution<int> coin(0, 1);
+        std::uniform_int_distribution<int> width(0, settings.window_width + 199);
+        std::uniform_int_distribution<int> height(0, settings.window_height + 199);
         for (int i = 0; i < 1; i++) {
-            float factor = rand() % 2 - 1;
-            float neg = rand() % 1 - 1;
-            float randX = outside_side_switch
+            float factor = coin(random.engine) - 1;
+            float neg = -1;
+            float randX = spawner.spawn_on_sides
                               ? neg * factor * (settings.window_width + 200)
-                              : rand() % (settings.window_width + 200);
+                              : width(random.engine);
             randX += camera.camera.target.x - camera.camera.offset.x - 100;
-            float randY = outside_side_switch
-                              ? rand() % (settings.window_height + 200)
+            float randY = spawner.spawn_on_sides
+                              ? height(random.engine)
                               : neg * factor * (settings.window_height + 200);
             randY += camera.camera.target.y - camera.camera.offset.y - 100;
             bool is_valid = true;
@@ -48,7 +51,7 @@ namespace gameplay::systems {
             });
 
 
-            outside_side_switch = !outside_side_switch;
+            spawner.spawn_on_sides = !spawner.spawn_on_sides;
 
             if (!is_valid) continue;
 
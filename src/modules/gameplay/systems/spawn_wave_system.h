@@ -0,0 +1,54 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SPAWN_WAVE_SYSTEM_H
+#define SPAWN_WAVE_SYSTEM_H
+
+#include <flecs.h>
+#include <random>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/gameplay/components.h"
+#include "modules/gameplay/wave_spawner.h"
+
+namespace gameplay::systems {
+    // same ring just outside the screen as the single spawner, rejected candidates are retried next tick
+    inline void spawn_wave_system(flecs::iter &iter, size_t i, Spawner &spawner, WaveSpawner &wave,
+                                  const core::GameSettings &settings, const rendering::TrackingCamera &camera,
+                                  core::Random &random) {
+        if (iter.world().get<core::Paused>().paused) return;
+
+        wave.elapsed += iter.delta_time();
+        if (wave.elapsed >= wave.wave_interval) {
+            wave.elapsed -= wave.wave_interval;
+            wave.pending += wave.wave_size;
+        }
+        if (wave.pending <= 0) return;
+
+        std::uniform_int_distribution<int> coin(0, 1);
+        std::uniform_int_distribution<int> width(0, settings.window_width + 199);
+        std::uniform_int_distribution<int> height(0, settings.window_height + 199);
+        float left = camera.camera.target.x - camera.camera.offset.x - 100;
+        float top = camera.camera.target.y - camera.camera.offset.y - 100;
+
+        std::vector<core::Position2D> candidates;
+        int batch = std::min(wave.pending, wave.per_tick_budget);
+        candidates.reserve(batch);
+        for (int c = 0; c < batch; c++) {
+            float edge = coin(random.engine) * (spawner.spawn_on_sides ? settings.window_width + 200
+                                                                        : settings.window_height + 200);
+            candidates.push_back({spawner.spawn_on_sides
+                                          ? Vector2{left + edge, top + height(random.engine)}
+                                          : Vector2{left + width(random.engine), top + edge}});
+            spawner.spawn_on_sides = !spawner.spawn_on_sides;
+        }
+
+        waves::reject_overlapping(iter.world(), candidates, spawner.enemy_prefab.get<physics::Collider>().bounds);
+        waves::bulk_spawn(iter.world(), spawner.enemy_prefab, iter.entity(i), candidates);
+        wave.pending -= static_cast<int>(candidates.size());
+    }
+}
+#endif //SPAWN_WAVE_SYSTEM_H
@@ -0,0 +1,88 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "wave_spawner.h"
+
+#include <cmath>
+#include <unordered_map>
+
+#include "modules/engine/physics/components.h"
+
+namespace gameplay::waves {
+    std::vector<flecs::entity_t> bulk_spawn(flecs::world world, flecs::entity prefab, flecs::entity parent,
+                                            const std::vector<core::Position2D> &positions) {
+        if (positions.empty()) return {};
+
+        // the prefab position is copied on instantiate, the provided column overwrites it in the same pass
+        std::vector<core::Position2D> column(positions);
+        void *data[] = {nullptr, nullptr, column.data()};
+
+        ecs_bulk_desc_t desc = {};
+        desc.ids[0] = ecs_isa(prefab);
+        desc.ids[1] = ecs_childof(parent);
+        desc.ids[2] = world.id<core::Position2D>();
+        desc.count = static_cast<int32_t>(column.size());
+        desc.data = data;
+        const flecs::entity_t *ids = ecs_bulk_init(world, &desc);
+        return {ids, ids + desc.count};
+    }
+
+    void reject_overlapping(flecs::world world, std::vector<core::Position2D> &candidates, Rectangle bounds) {
+        if (candidates.empty()) return;
+
+        // cells as large as the spawned bounds, a collider can only touch candidates in the cells it covers
+        // once its rectangle is grown by the spawned bounds
+        const float cell_size = std::max(bounds.width, bounds.height);
+        auto cell_of = [cell_size](float v) { return static_cast<long>(std::floor(v / cell_size)); };
+
+        std::unordered_map<std::pair<long, long>, std::vector<size_t>, physics::IdPairHash> cells;
+        std::vector<bool> rejected(candidates.size(), false);
+        for (size_t i = 0; i < candidates.size(); i++) {
+            const Vector2 &p = candidates[i].value;
+            std::pair<long, long> key{cell_of(p.x), cell_of(p.y)};
+
+            // candidates closer than a cell to an accepted one overlap it
+            bool overlaps = false;
+            for (long x = key.first - 1; x <= key.first + 1 && !overlaps; x++) {
+                for (long y = key.second - 1; y <= key.second + 1 && !overlaps; y++) {
+                    auto it = cells.find({x, y});
+                    if (it == cells.end()) continue;
+                    for (size_t other: it->second) {
+                        const Vector2 &o = candidates[other].value;
+                        if (std::fabs(o.x - p.x) < bounds.width && std::fabs(o.y - p.y) < bounds.height) {
+                            overlaps = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (overlaps) {
+                rejected[i] = true;
+                continue;
+            }
+            cells[key].push_back(i);
+        }
+
+        world.each([&](const core::Position2D &pos, const physics::Collider &collider) {
+            Rectangle rec = {pos.value.x + collider.bounds.x - bounds.x - bounds.width,
+                             pos.value.y + collider.bounds.y - bounds.y - bounds.height,
+                             collider.bounds.width + bounds.width, collider.bounds.height + bounds.height};
+            for (long x = cell_of(rec.x); x <= cell_of(rec.x + rec.width); x++) {
+                for (long y = cell_of(rec.y); y <= cell_of(rec.y + rec.height); y++) {
+                    auto it = cells.find({x, y});
+                    if (it == cells.end()) continue;
+                    for (size_t i: it->second) {
+                        if (CheckCollisionPointRec(candidates[i].value, rec)) rejected[i] = true;
+                    }
+                }
+            }
+        });
+
+        size_t kept = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (!rejected[i]) candidates[kept++] = candidates[i];
+        }
+        candidates.resize(kept);
+    }
+}
@@ -0,0 +1,32 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef WAVE_SPAWNER_H
+#define WAVE_SPAWNER_H
+
+#include <vector>
+
+#include <flecs.h>
+#include <raylib.h>
+
+#include "modules/engine/core/components.h"
+
+namespace gameplay::waves {
+    /**
+     * Create one instance of the prefab under the parent per position with a single ecs_bulk_init, the position
+     * column is written directly. The world must not be deferred.
+     * @return the created entities, in the order of the positions
+     */
+    std::vector<flecs::entity_t> bulk_spawn(flecs::world world, flecs::entity prefab, flecs::entity parent,
+                    const std::vector<core::Position2D> &positions);
+
+    /**
+     * Drop the candidates whose bounds overlap an existing collider or an already accepted candidate. The
+     * candidates are bucketed once in a local grid and every collider is visited once.
+     * @param bounds collider bounds of the entity that would be spawned, relative to its position
+     */
+    void reject_overlapping(flecs::world world, std::vector<core::Position2D> &candidates, Rectangle bounds);
+}
+
+#endif //WAVE_SPAWNER_H
@@ -0,0 +1,100 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "chunks.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tiles.h"
+
+namespace tilemap::chunks {
+    uint64_t key(int layer, int chunk_x, int chunk_y) {
+        return static_cast<uint64_t>(layer & 0xFFFF) << 48 | static_cast<uint64_t>(chunk_y & 0xFFFFFF) << 24 |
+               static_cast<uint64_t>(chunk_x & 0xFFFFFF);
+    }
+
+    Rectangle bounds(const TilemapChunks &chunks, int chunk_x, int chunk_y) {
+        const float width = chunks.tile_width * chunks.scale;
+        const float height = chunks.tile_height * chunks.scale;
+        return {
+                chunk_x * CHUNK_TILES * width - width / 2.0f,
+                chunk_y * CHUNK_TILES * height - height / 2.0f,
+                CHUNK_TILES * width,
+                CHUNK_TILES * height,
+        };
+    }
+
+    Range visible(const TilemapChunks &chunks, Rectangle view) {
+        int map_width = 0;
+        int map_height = 0;
+        for (const TilemapLayer &layer: chunks.layers) {
+            map_width = std::max(map_width, layer.width);
+            map_height = std::max(map_height, layer.height);
+        }
+        const float chunk_width = CHUNK_TILES * chunks.tile_width * chunks.scale;
+        const float chunk_height = CHUNK_TILES * chunks.tile_height * chunks.scale;
+        const Rectangle first = bounds(chunks, 0, 0);
+        return {
+                std::max(0, static_cast<int>(std::floor((view.x - first.x) / chunk_width))),
+                std::max(0, static_cast<int>(std::floor((view.y - first.y) / chunk_height))),
+                std::min((map_width - 1) / CHUNK_TILES,
+                         static_cast<int>(std::floor((view.x + view.width - first.x) / chunk_width))),
+                std::min((map_height - 1) / CHUNK_TILES,
+                         static_cast<int>(std::floor((view.y + view.height - first.y) / chunk_height))),
+        };
+    }
+
+    Image bake(const TilemapChunks &chunks, int layer, int chunk_x, int chunk_y) {
+        const TilemapLayer &tiles = chunks.layers[layer];
+        const Rectangle area = bounds(chunks, chunk_x, chunk_y);
+        Image image = GenImageColor(static_cast<int>(area.width), static_cast<int>(area.height), BLANK);
+
+        const int first_x = chunk_x * CHUNK_TILES;
+        const int first_y = chunk_y * CHUNK_TILES;
+        for (int y = first_y; y < std::min(first_y + CHUNK_TILES, tiles.height); y++) {
+            for (int x = first_x; x < std::min(first_x + CHUNK_TILES, tiles.width); x++) {
+                const uint32_t gid = tiles.gids[y * tiles.width + x];
+                const int tileset = tiles::find(chunks.ranges, gid);
+                if (tileset < 0) continue;
+
+                const Rectangle source = tiles::source(chunks.ranges[tileset], gid);
+                const float width = std::abs(source.width);
+                const float height = std::abs(source.height);
+                Image tile = ImageFromImage(chunks.tilesets[tileset], {source.x, source.y, width, height});
+                if (source.width < 0) ImageFlipHorizontal(&tile);
+                if (source.height < 0) ImageFlipVertical(&tile);
+                // diagonal flips are the only rotation the maps use
+                if (tiles::rotation(gid) < 0.0f) ImageRotateCCW(&tile);
+
+                Rectangle destination{
+                        (x - first_x) * chunks.tile_width * chunks.scale,
+                        (y - first_y) * chunks.tile_height * chunks.scale,
+                        width * chunks.scale,
+                        height * chunks.scale,
+                };
+                ImageDraw(&image, tile, {0, 0, static_cast<float>(tile.width), static_cast<float>(tile.height)},
+                          destination, WHITE);
+                UnloadImage(tile);
+            }
+        }
+        return image;
+    }
+
+    void trim(TilemapChunks &chunks, std::vector<Texture2D> &released) {
+        while (chunks.bytes > chunks.budget) {
+            auto oldest = chunks.resident.end();
+            for (auto it = chunks.resident.begin(); it != chunks.resident.end(); ++it) {
+                if (it->second.last_used == chunks.frame) continue;
+                if (oldest == chunks.resident.end() || it->second.last_used < oldest->second.last_used)
+                    oldest = it;
+            }
+            if (oldest == chunks.resident.end()) return;
+
+            chunks.bytes -= oldest->second.bytes;
+            released.push_back(oldest->second.texture);
+            chunks.resident.erase(oldest);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef TILEMAP_CHUNKS_H
+#define TILEMAP_CHUNKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace tilemap::chunks {
+    // tiles per chunk side
+    constexpr int CHUNK_TILES = 16;
+    constexpr size_t DEFAULT_BUDGET = 128 * 1024 * 1024;
+    // uploads are spread over frames, a chunk that doesn't make it is drawn the next frame
+    constexpr int BAKES_PER_FRAME = 4;
+
+    struct Range {
+        int min_x;
+        int min_y;
+        int max_x;
+        int max_y;
+    };
+
+    uint64_t key(int layer, int chunk_x, int chunk_y);
+
+    // world rectangle covered by the chunk, tiles are centered on their grid position like the colliders
+    Rectangle bounds(const TilemapChunks &chunks, int chunk_x, int chunk_y);
+
+    // chunks of the map overlapping the view, empty when max < min
+    Range visible(const TilemapChunks &chunks, Rectangle view);
+
+    /**
+     * Draws the tiles of one chunk with CPU image ops, flips and rotations included. Doesn't need a GL context so the
+     * result can be checked pixel by pixel.
+     */
+    Image bake(const TilemapChunks &chunks, int layer, int chunk_x, int chunk_y);
+
+    /**
+     * Drops the least recently used chunks until the resident ones fit the budget, chunks drawn this frame are
+     * never dropped. The caller unloads the released textures.
+     */
+    void trim(TilemapChunks &chunks, std::vector<Texture2D> &released);
+}
+
+#endif //TILEMAP_CHUNKS_H
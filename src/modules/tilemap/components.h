@@ -4,7 +4,10 @@
 
 #ifndef TILEMAP_COMPONENTS_H
 #define TILEMAP_COMPONENTS_H
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <raylib.h>
 #include <raymath.h>
 #include "tmxlite/Types.hpp"
@@ -17,13 +20,54 @@ namespace tilemap {
     };
 
     struct TilemapTileset {
-        Texture2D texture;
+        // kept on the CPU and owned by the asset store, chunks are baked from it with image ops and only the chunks
+        // are uploaded
+        Image image;
+    };
+
+    // gid range of a tileset and the grid of its image, see tiles::source
+    struct TilesetRange {
+        uint32_t first_gid;
+        uint32_t last_gid;
+        int columns;
+        int margin;
+        int spacing;
+        float tile_width;
+        float tile_height;
     };
 
     struct TilemapLayer {
+        std::string name;
+        int width;
+        int height;
+        // Tiled gid of every cell, row major, the flips in the top bits and 0 when empty
+        std::vector<uint32_t> gids;
+    };
+
+    // baked square of CHUNK_TILES tiles of one layer, resident on the GPU
+    struct TilemapChunk {
         Texture2D texture;
+        size_t bytes;
+        uint64_t last_used;
+    };
+
+    // the layers are baked lazily per chunk as the camera reaches them, least recently drawn chunks are unloaded
+    // once the resident ones go over the budget
+    struct TilemapChunks {
+        // sorted by first gid, tilesets[i] is the image of ranges[i]
+        std::vector<TilesetRange> ranges;
+        std::vector<Image> tilesets;
+        std::vector<TilemapLayer> layers;
+        float tile_width;
+        float tile_height;
+        float scale;
+        std::unordered_map<uint64_t, TilemapChunk> resident;
+        size_t bytes;
+        size_t budget;
+        uint64_t frame;
     };
 
+    // only the tiles with properties get an entity
     struct TilemapLayerTile {
         flecs::entity_t tileset;
         Rectangle source;
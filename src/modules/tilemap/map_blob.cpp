@@ -0,0 +1,207 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "map_blob.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tilemap::map_blob {
+    static_assert(sizeof(TilesetRange) % 4 == 0 && sizeof(Rectangle) == 16, "the blob stays 4 byte aligned");
+
+    // read only view of the file, mapped where the platform allows it
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &path) {
+#if defined(_WIN32)
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) return;
+            m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            m_data = reinterpret_cast<const uint8_t *>(m_buffer.data());
+            m_size = m_buffer.size();
+#else
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat info{};
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                void *mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    m_data = static_cast<const uint8_t *>(mapped);
+                    m_size = static_cast<size_t>(info.st_size);
+                }
+            }
+            close(fd);
+#endif
+        }
+
+        ~MappedFile() {
+#if !defined(_WIN32)
+            if (m_data) munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const uint8_t *data() const { return m_data; }
+        size_t size() const { return m_size; }
+
+    private:
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+#if defined(_WIN32)
+        std::vector<char> m_buffer;
+#endif
+    };
+
+    // bounds checked walk over the mapped bytes
+    struct Cursor {
+        const uint8_t *data;
+        size_t size;
+        size_t offset;
+
+        // whether `count` elements are left, checked before sizing anything from a count read off the file
+        template<typename T>
+        bool fits(size_t count) const {
+            return offset <= size && count <= (size - offset) / sizeof(T);
+        }
+
+        template<typename T>
+        bool take(T *out, size_t count) {
+            const size_t bytes = sizeof(T) * count;
+            if (count > size || offset + bytes > size) return false;
+            if (bytes > 0) std::memcpy(out, data + offset, bytes);
+            offset += bytes;
+            return true;
+        }
+    };
+
+    static size_t padded(size_t bytes) { return (bytes + 3) & ~static_cast<size_t>(3); }
+
+    std::string path_for(const std::string &tmx_path) {
+        return std::filesystem::path(tmx_path).replace_extension(EXTENSION).string();
+    }
+
+    bool write(const std::string &path, const MapData &data) {
+        std::string strings;
+        std::vector<TilesetRecord> tilesets;
+        for (const TilesetReference &tileset: data.tilesets) {
+            tilesets.push_back({tileset.range, static_cast<uint32_t>(strings.size()),
+                                static_cast<uint32_t>(tileset.image_path.size())});
+            strings += tileset.image_path;
+        }
+        std::vector<LayerRecord> layers;
+        for (const TilemapLayer &layer: data.layers) {
+            layers.push_back({static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(layer.name.size()),
+                              static_cast<uint32_t>(layer.width), static_cast<uint32_t>(layer.height)});
+            strings += layer.name;
+        }
+
+        Header header{
+                MAGIC,
+                VERSION,
+                static_cast<uint32_t>(data.width),
+                static_cast<uint32_t>(data.height),
+                data.tile_width,
+                data.tile_height,
+                static_cast<uint32_t>(tilesets.size()),
+                static_cast<uint32_t>(layers.size()),
+                static_cast<uint32_t>(data.colliders.size()),
+                static_cast<uint32_t>(data.property_tiles.size()),
+                static_cast<uint32_t>(strings.size()),
+        };
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        auto write_bytes = [&file](const void *bytes, size_t size) {
+            file.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+        };
+        write_bytes(&header, sizeof(header));
+        write_bytes(tilesets.data(), tilesets.size() * sizeof(TilesetRecord));
+        write_bytes(layers.data(), layers.size() * sizeof(LayerRecord));
+        write_bytes(data.colliders.data(), data.colliders.size() * sizeof(Rectangle));
+        write_bytes(data.property_tiles.data(), data.property_tiles.size() * sizeof(PropertyTile));
+        std::vector<uint8_t> blocked = data.blocked;
+        blocked.resize(padded(static_cast<size_t>(data.width) * data.height), 0);
+        write_bytes(blocked.data(), blocked.size());
+        for (const TilemapLayer &layer: data.layers)
+            write_bytes(layer.gids.data(), layer.gids.size() * sizeof(uint32_t));
+        write_bytes(strings.data(), strings.size());
+        return file.good();
+    }
+
+    bool read(const std::string &path, MapData &data) {
+        MappedFile file(path);
+        if (!file.data()) return false;
+
+        Cursor cursor{file.data(), file.size(), 0};
+        Header header{};
+        if (!cursor.take(&header, 1) || header.magic != MAGIC || header.version != VERSION) return false;
+
+        // a truncated or corrupt file fails here instead of allocating whatever its counts claim
+        std::vector<TilesetRecord> tilesets;
+        std::vector<LayerRecord> layers;
+        MapData loaded{static_cast<int>(header.width), static_cast<int>(header.height), header.tile_width,
+                       header.tile_height, {}, {}, {}, {}, {}};
+        if (!cursor.fits<TilesetRecord>(header.tileset_count)) return false;
+        tilesets.resize(header.tileset_count);
+        if (!cursor.take(tilesets.data(), tilesets.size()) || !cursor.fits<LayerRecord>(header.layer_count))
+            return false;
+        layers.resize(header.layer_count);
+        if (!cursor.take(layers.data(), layers.size()) || !cursor.fits<Rectangle>(header.collider_count)) return false;
+        loaded.colliders.resize(header.collider_count);
+        if (!cursor.take(loaded.colliders.data(), loaded.colliders.size()) ||
+            !cursor.fits<PropertyTile>(header.property_tile_count))
+            return false;
+        loaded.property_tiles.resize(header.property_tile_count);
+        const size_t cells = static_cast<size_t>(header.width) * header.height;
+        if (!cursor.take(loaded.property_tiles.data(), loaded.property_tiles.size()) ||
+            !cursor.fits<uint8_t>(padded(cells)))
+            return false;
+        std::vector<uint8_t> blocked(padded(cells));
+        if (!cursor.take(blocked.data(), blocked.size())) return false;
+        blocked.resize(cells);
+        loaded.blocked = std::move(blocked);
+
+        for (const LayerRecord &record: layers) {
+            // the blocked cells and the collision grid are laid out over the map, every layer has to cover it
+            if (record.width != header.width || record.height != header.height) return false;
+            TilemapLayer &layer = loaded.layers.emplace_back();
+            layer.width = static_cast<int>(record.width);
+            layer.height = static_cast<int>(record.height);
+            const size_t layer_cells = static_cast<size_t>(record.width) * record.height;
+            if (!cursor.fits<uint32_t>(layer_cells)) return false;
+            layer.gids.resize(layer_cells);
+            if (!cursor.take(layer.gids.data(), layer.gids.size())) return false;
+        }
+        // the level indexes the layer gids with them directly
+        for (const PropertyTile &tile: loaded.property_tiles)
+            if (tile.layer >= loaded.layers.size() || tile.cell >= loaded.layers[tile.layer].gids.size()) return false;
+
+        const size_t strings = cursor.offset;
+        if (strings + header.string_bytes > file.size()) return false;
+        auto string_at = [&](uint32_t offset, uint32_t length) {
+            if (static_cast<size_t>(offset) + length > header.string_bytes) return std::string();
+            return std::string(reinterpret_cast<const char *>(file.data() + strings + offset), length);
+        };
+        for (const TilesetRecord &record: tilesets)
+            loaded.tilesets.push_back({record.range, string_at(record.path_offset, record.path_length)});
+        for (size_t i = 0; i < layers.size(); i++)
+            loaded.layers[i].name = string_at(layers[i].name_offset, layers[i].name_length);
+
+        data = std::move(loaded);
+        return true;
+    }
+}
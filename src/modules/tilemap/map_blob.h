@@ -0,0 +1,60 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef TILEMAP_MAP_BLOB_H
+#define TILEMAP_MAP_BLOB_H
+
+#include <cstdint>
+#include <string>
+
+#include "map_data.h"
+
+namespace tilemap::map_blob {
+    constexpr uint32_t MAGIC = 0x00424D54; // "TMB"
+    // bump when the layout changes, older blobs are then ignored and the tmx is parsed instead
+    constexpr uint32_t VERSION = 1;
+    constexpr const char *EXTENSION = ".tmb";
+
+    /**
+     * Layout, little endian and 4 byte aligned:
+     * header, tileset records, layer records, merged colliders, property tiles, the blocked bitmap padded to 4 bytes,
+     * the gids of every layer one after the other, then the string table the records point into.
+     */
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        float tile_width;
+        float tile_height;
+        uint32_t tileset_count;
+        uint32_t layer_count;
+        uint32_t collider_count;
+        uint32_t property_tile_count;
+        uint32_t string_bytes;
+    };
+
+    struct TilesetRecord {
+        TilesetRange range;
+        uint32_t path_offset;
+        uint32_t path_length;
+    };
+
+    struct LayerRecord {
+        uint32_t name_offset;
+        uint32_t name_length;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // the .tmb next to the map
+    std::string path_for(const std::string &tmx_path);
+
+    bool write(const std::string &path, const MapData &data);
+
+    // maps the file and copies the arrays out of it, false when it's missing, truncated or of another version
+    bool read(const std::string &path, MapData &data);
+}
+
+#endif //TILEMAP_MAP_BLOB_H
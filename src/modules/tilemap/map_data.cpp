@@ -0,0 +1,123 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "map_data.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include <tmxlite/Layer.hpp>
+#include <tmxlite/Map.hpp>
+#include <tmxlite/TileLayer.hpp>
+
+#include "tiles.h"
+
+namespace tilemap::map_data {
+    bool from_tmx(const std::string &path, MapData &data) {
+        tmx::Map map;
+        if (!map.load(path)) return false;
+
+        data = {static_cast<int>(map.getTileCount().x), static_cast<int>(map.getTileCount().y),
+                static_cast<float>(map.getTileSize().x), static_cast<float>(map.getTileSize().y), {}, {}, {}, {}, {}};
+
+        // sorted by first gid so a tile finds its tileset with a binary search
+        std::vector<const tmx::Tileset *> sorted_tilesets;
+        for (const auto &tileset: map.getTilesets()) sorted_tilesets.push_back(&tileset);
+        std::sort(sorted_tilesets.begin(), sorted_tilesets.end(), [](const tmx::Tileset *a, const tmx::Tileset *b) {
+            return a->getFirstGID() < b->getFirstGID();
+        });
+        const std::filesystem::path map_directory = std::filesystem::path(path).parent_path();
+        std::vector<TilesetRange> ranges;
+        for (const tmx::Tileset *tileset: sorted_tilesets) {
+            ranges.push_back({
+                    tileset->getFirstGID(), tileset->getLastGID(), static_cast<int>(tileset->getColumnCount()),
+                    static_cast<int>(tileset->getMargin()), static_cast<int>(tileset->getSpacing()),
+                    static_cast<float>(tileset->getTileSize().x), static_cast<float>(tileset->getTileSize().y),
+            });
+            std::string image = std::filesystem::path(tileset->getImagePath()).lexically_relative(map_directory)
+                                        .generic_string();
+            data.tilesets.push_back({ranges.back(), image});
+        }
+
+        data.blocked.assign(data.width * data.height, 0);
+        for (const auto &layer: map.getLayers()) {
+            if (layer->getType() != tmx::Layer::Type::Tile) continue;
+
+            const auto &tile_layer = layer->getLayerAs<tmx::TileLayer>();
+            TilemapLayer &cells = data.layers.emplace_back();
+            cells.name = tile_layer.getName();
+            cells.width = static_cast<int>(tile_layer.getSize().x);
+            cells.height = static_cast<int>(tile_layer.getSize().y);
+            cells.gids.resize(cells.width * cells.height);
+
+            const auto &tiles = tile_layer.getTiles();
+            for (size_t index = 0; index < tiles.size() && index < cells.gids.size(); index++) {
+                const uint32_t gid = tiles::gid(tiles[index].ID, tiles[index].flipFlags);
+                cells.gids[index] = gid;
+
+                const int tileset = tiles::find(ranges, gid);
+                if (tileset < 0) continue;
+                auto tile = sorted_tilesets[tileset]->getTile(tiles[index].ID);
+                if (tile == nullptr || tile->properties.empty()) continue;
+
+                data.property_tiles.push_back(
+                        {static_cast<uint32_t>(data.layers.size() - 1), static_cast<uint32_t>(index)});
+                for (const auto &property: tile->properties) {
+                    if (property.getName() == "collide" && property.getBoolValue() && index < data.blocked.size())
+                        data.blocked[index] = 1;
+                }
+            }
+        }
+
+        data.colliders = merge_colliders(data.blocked, data.width, data.height);
+        return true;
+    }
+
+    std::vector<Rectangle> merge_colliders(const std::vector<uint8_t> &blocked, int width, int height) {
+        std::vector<uint8_t> collision_map = blocked;
+        std::vector<Rectangle> merged_colliders;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                // If this tile is not a collision or has already been merged, skip it
+                if (!collision_map[y * width + x]) {
+                    continue;
+                }
+
+                // Found an unmerged collision tile, start a new rectangle from here
+                int rect_width = 1;
+                int rect_height = 1;
+
+                // 1. Extend to the right to find maximum width
+                while (x + rect_width < width && collision_map[y * width + x + rect_width]) {
+                    rect_width++;
+                }
+
+                // 2. Extend downwards while the entire row below is collidable
+                bool can_extend_down = true;
+                while (can_extend_down && y + rect_height < height) {
+                    for (int current_x = x; current_x < x + rect_width; ++current_x) {
+                        if (!collision_map[(y + rect_height) * width + current_x]) {
+                            can_extend_down = false;
+                            break;
+                        }
+                    }
+                    if (can_extend_down) {
+                        rect_height++;
+                    }
+                }
+
+                // Mark all tiles within this rectangle as processed
+                for (int mark_y = y; mark_y < y + rect_height; ++mark_y) {
+                    for (int mark_x = x; mark_x < x + rect_width; ++mark_x) {
+                        collision_map[mark_y * width + mark_x] = 0;
+                    }
+                }
+
+                merged_colliders.push_back({static_cast<float>(x), static_cast<float>(y),
+                                            static_cast<float>(rect_width), static_cast<float>(rect_height)});
+            }
+        }
+        return merged_colliders;
+    }
+}
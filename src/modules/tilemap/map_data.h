@@ -0,0 +1,54 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef TILEMAP_MAP_DATA_H
+#define TILEMAP_MAP_DATA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace tilemap {
+    struct TilesetReference {
+        TilesetRange range;
+        // relative to the map file
+        std::string image_path;
+    };
+
+    // a tile with properties, the only tiles that get an entity
+    struct PropertyTile {
+        uint32_t layer;
+        uint32_t cell;
+    };
+
+    // everything a level needs from a map, in tiles, the scale is applied when the level is built
+    struct MapData {
+        int width;
+        int height;
+        float tile_width;
+        float tile_height;
+        // sorted by first gid
+        std::vector<TilesetReference> tilesets;
+        std::vector<TilemapLayer> layers;
+        // 1 per tile that collides, ready for physics::CollisionGrid and the flow field
+        std::vector<uint8_t> blocked;
+        // greedy merge of the blocked tiles
+        std::vector<Rectangle> colliders;
+        std::vector<PropertyTile> property_tiles;
+    };
+}
+
+namespace tilemap::map_data {
+    // parses the tmx with tmxlite, the slow path the map compiler runs offline
+    bool from_tmx(const std::string &path, MapData &data);
+
+    // grows every unmerged blocked tile right then down into the largest rectangle, in tiles
+    std::vector<Rectangle> merge_colliders(const std::vector<uint8_t> &blocked, int width, int height);
+}
+
+#endif //TILEMAP_MAP_DATA_H
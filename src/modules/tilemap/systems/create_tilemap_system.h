@@ -4,214 +4,138 @@
 
 #ifndef CREATE_TILEMAP_SYSTEM_H
 #define CREATE_TILEMAP_SYSTEM_H
+#include <filesystem>
 #include <flecs.h>
 
-#include <tmxlite/Map.hpp>
-#include <tmxlite/Layer.hpp>
-#include <tmxlite/TileLayer.hpp>
-#include <tmxlite/ObjectGroup.hpp>
-
+#include "modules/engine/assets/asset_store.h"
 #include "modules/engine/core/components.h"
 #include "modules/engine/physics/components.h"
 #include "modules/engine/physics/physics_module.h"
-#include "modules/engine/rendering/components.h"
+#include "modules/tilemap/chunks.h"
 #include "modules/tilemap/components.h"
+#include "modules/tilemap/map_blob.h"
+#include "modules/tilemap/map_data.h"
+#include "modules/tilemap/tiles.h"
 
 
 namespace tilemap::systems {
-    inline void create_tilemap_system(flecs::entity e, const Tilemap &tilemap) {
-        if (tmx::Map map; map.load(tilemap.tmx_file_path)) {
-            const auto &tilesets = map.getTilesets();
-            std::vector<std::tuple<flecs::entity, tmx::Tileset, Texture> > tileset_first_gids;
-            for (const auto &tileset: tilesets) {
-                Texture2D t = LoadTexture(tileset.getImagePath().c_str());
-                flecs::entity tilemap_tileset = e.world().entity().child_of(e)
-                        .set<TilemapTileset>({
-                            t
-                        });
-                tileset_first_gids.emplace_back(tilemap_tileset, tileset, t);
-            }
-            std::vector<bool> collision_map(map.getTileCount().x * map.getTileCount().y);
-
-            for (const auto &layers = map.getLayers(); const auto &layer: layers) {
-                if (layer->getType() == tmx::Layer::Type::Tile) {
-                    RenderTexture2D layer_texture = LoadRenderTexture(
-                        layer->getSize().x * map.getTileSize().x * tilemap.scale,
-                        layer->getSize().y * map.getTileSize().y * tilemap.scale);
-                    BeginTextureMode(layer_texture);
-                    ClearBackground(BLANK);
-                    const auto &tileLayer = layer->getLayerAs<tmx::TileLayer>();
-                    //read out tile layer properties etc...
-                    tmx::Vector2u size = tileLayer.getSize();
-
-                    flecs::entity layer_entity = e.world().entity(tileLayer.getName().c_str()).child_of(e);
-
-                    const auto &tiles = tileLayer.getTiles();
-                    for (int x = 0; x < size.x; x++) {
-                        for (int y = 0; y < size.y; y++) {
-                            int index = y * size.x + x;
-                            int tile_id = tiles[index].ID;
-                            auto tileset = tileset_first_gids[0];
-                            for (int i = 0; i < tileset_first_gids.size(); i++) {
-                                int first_id = std::get<1>(tileset_first_gids[i]).getFirstGID();
-                                int last_id = std::get<1>(tileset_first_gids[i]).getLastGID();
-                                if (tile_id >= first_id && tile_id < last_id) {
-                                    tileset = tileset_first_gids[i];
-                                    break;
-                                }
-                            }
-
-                            auto tile = std::get<1>(tileset).getTile(tile_id);
-                            if (tile == nullptr) continue;
-                            if (tiles[index].ID == 0) continue;
-
-                            int width = tile->imageSize.x;
-                            int height = tile->imageSize.y;
-                            float rotation = 0.0f;
-                            if (tiles[index].flipFlags & tmx::TileLayer::FlipFlag::Diagonal) {
-                                rotation = -90;
-                                height = -height;
-                            }
-                            if (tiles[index].flipFlags & tmx::TileLayer::FlipFlag::Horizontal) {
-                                width = -width;
-                            }
-                            if (tiles[index].flipFlags & tmx::TileLayer::FlipFlag::Vertical) {
-                                height = -height;
-                            }
-
-                            Rectangle source{
-                                (float) tile->imagePosition.x,
-                                (float) tile->imagePosition.y,
-                                (float) width,
-                                (float) height
-                            };
-                            Rectangle destination{
-                                (float) x * tilemap.scale * tile->imageSize.x,
-                                (float) y * tilemap.scale * tile->imageSize.y,
-                                (float) tile->imageSize.x * tilemap.scale,
-                                (float) tile->imageSize.y * tilemap.scale
-                            };
-
-                            Vector2 origin{
-                                destination.width / 2.f,
-                                destination.height / 2.f
-                            };
-
-
-                            flecs::entity tile_entity = e.world().entity().child_of(layer_entity)
-                                    .set<TilemapLayerTile>({
-                                        std::get<0>(tileset),
-                                        source,
-                                        destination,
-                                        rotation,
-                                    });
-
-                            if (!tile->properties.empty()) {
-                                for (int i = 0; i < tile->properties.size(); i++) {
-                                    if (tile->properties[i].getName() == "collide") {
-                                        if (tile->properties[i].getBoolValue()) {
-                                            collision_map[index] = true;
-                                        }
-                                    }
-                                }
-                            }
+    // the compiled .tmb when it's there and newer than the map, the tmx is only parsed as a fallback
+    inline bool load_map_data(const std::string &tmx_path, MapData &data) {
+        const std::string blob_path = map_blob::path_for(tmx_path);
+        std::error_code error;
+        const bool stale = std::filesystem::exists(tmx_path, error) &&
+                           std::filesystem::last_write_time(tmx_path, error) >
+                           std::filesystem::last_write_time(blob_path, error);
+        if (!stale && map_blob::read(blob_path, data)) return true;
+        return map_data::from_tmx(tmx_path, data);
+    }
 
-                            DrawTexturePro(
-                                std::get<2>(tileset),
-                                source,
-                                destination,
-                                origin,
-                                rotation,
-                                WHITE
-                            );
-                        }
-                    }
-                    EndTextureMode();
-                    //
-                    RenderTexture2D inverted = LoadRenderTexture(
-                        layer->getSize().x * map.getTileSize().x * tilemap.scale,
-                        layer->getSize().y * map.getTileSize().y * tilemap.scale);
-                    BeginTextureMode(inverted);
-                    DrawTexture(layer_texture.texture, 0, 0,WHITE);
-                    EndTextureMode();
-                    layer_entity
-                            .set<rendering::Renderable>({
-                                inverted.texture, {0, 0}, 1.0f, WHITE
-                            })
-                            .set<rendering::Priority>({0});
-                }
+    /**
+     * Polled every frame until the map and its tileset images are decoded by the asset store, the requests are
+     * deduplicated so asking again is only a lookup.
+     */
+    inline void create_tilemap_system(flecs::entity e, const Tilemap &tilemap, assets::AssetStore &store) {
+        const std::string tmx_path = tilemap.tmx_file_path;
+        assets::AssetHandle map = assets::request_data(store, tmx_path, [tmx_path]() -> std::shared_ptr<void> {
+            auto data = std::make_shared<MapData>();
+            if (!load_map_data(tmx_path, *data)) return nullptr;
+            return data;
+        });
+        if (assets::failed(store, map)) {
+            TraceLog(LOG_WARNING, "TILEMAP: couldn't load %s", tmx_path.c_str());
+            e.remove<Tilemap>();
+            return;
+        }
+        const MapData *loaded = assets::get_data<MapData>(store, map);
+        if (!loaded) return;
+
+        const std::filesystem::path map_directory = std::filesystem::path(tmx_path).parent_path();
+        std::vector<const Image *> images;
+        for (const TilesetReference &tileset: loaded->tilesets) {
+            const std::string image_path = (map_directory / tileset.image_path).string();
+            assets::AssetHandle image = assets::request_image(store, image_path);
+            if (assets::failed(store, image)) {
+                TraceLog(LOG_WARNING, "TILEMAP: couldn't load tileset %s of %s", image_path.c_str(), tmx_path.c_str());
+                e.remove<Tilemap>();
+                return;
             }
+            images.push_back(assets::get_image(store, image));
+        }
+        for (const Image *image: images)
+            if (!image) return;
+
+        // the store keeps its copy for the other maps using it
+        MapData data = *loaded;
+
+        // nothing is uploaded here, the layers are baked per chunk when the camera gets to them
+        TilemapChunks chunks{
+            {}, {}, {}, data.tile_width, data.tile_height, tilemap.scale, {}, 0, chunks::DEFAULT_BUDGET, 0
+        };
+        std::vector<flecs::entity> tileset_entities;
+        for (size_t i = 0; i < data.tilesets.size(); i++) {
+            tileset_entities.push_back(e.world().entity().child_of(e)
+                    .set<TilemapTileset>({
+                        *images[i]
+                    }));
+            chunks.tilesets.push_back(*images[i]);
+            chunks.ranges.push_back(data.tilesets[i].range);
+        }
 
-            std::vector<Rectangle> merged_colliders;
-            for (int y = 0; y < map.getTileCount().y; ++y) {
-                for (int x = 0; x < map.getTileCount().x; ++x) {
-                    int current_index = y * map.getTileCount().x + x;
-
-                    // If this tile is not a collision or has already been merged, skip it
-                    if (!collision_map[current_index]) {
-                        continue;
-                    }
-
-                    // Found an unmerged collision tile, start a new rectangle from here
-                    int rect_x = x;
-                    int rect_y = y;
-                    int rect_width = 1;
-                    int rect_height = 1;
-
-                    // 1. Extend to the right to find maximum width
-                    // While the next tile to the right exists and is a collision
-                    while (rect_x + rect_width < map.getTileCount().x &&
-                           collision_map[y * map.getTileCount().x + (rect_x + rect_width)]) {
-                        rect_width++;
-                    }
-
-                    // 2. Extend downwards to find maximum height
-                    // We need to check if the entire proposed row below is clear (collidable)
-                    bool can_extend_down = true;
-                    while (can_extend_down && rect_y + rect_height < map.getTileCount().y) {
-                        // Check the entire row at current_y + rect_height for collisions within current rect_width
-                        for (int current_rect_x = rect_x; current_rect_x < rect_x + rect_width; ++current_rect_x) {
-                            if (!collision_map[(rect_y + rect_height) * map.getTileCount().x + current_rect_x]) {
-                                can_extend_down = false;
-                                break; // This row cannot be fully extended
-                            }
-                        }
-                        if (can_extend_down) {
-                            rect_height++;
-                        }
-                    }
-
-                    // Now we have the largest possible rectangle starting at (rect_x, rect_y)
-                    // Mark all tiles within this rectangle as processed in the collision_map
-                    for (int mark_y = rect_y; mark_y < rect_y + rect_height; ++mark_y) {
-                        for (int mark_x = rect_x; mark_x < rect_x + rect_width; ++mark_x) {
-                            collision_map[mark_y * map.getTileCount().x + mark_x] = false;
-                        }
-                    }
-
-                    // Add the new merged rectangle to our list
-                    merged_colliders.push_back({
-                        rect_x * map.getTileSize().x * tilemap.scale - map.getTileSize().x * tilemap.scale / 2.0f,
-                        rect_y * map.getTileSize().y * tilemap.scale - map.getTileSize().y * tilemap.scale / 2.0f,
-                        rect_width * map.getTileSize().x * tilemap.scale,
-                        rect_height * map.getTileSize().y * tilemap.scale
+        std::vector<flecs::entity> layer_entities;
+        for (const TilemapLayer &layer: data.layers)
+            layer_entities.push_back(e.world().entity(layer.name.c_str()).child_of(e));
+
+        // only tiles with gameplay properties become entities
+        for (const PropertyTile &property_tile: data.property_tiles) {
+            const TilemapLayer &layer = data.layers[property_tile.layer];
+            const uint32_t gid = layer.gids[property_tile.cell];
+            const int tileset = tiles::find(chunks.ranges, gid);
+            if (tileset < 0) continue;
+
+            const TilesetRange &range = chunks.ranges[tileset];
+            int x = static_cast<int>(property_tile.cell) % layer.width;
+            int y = static_cast<int>(property_tile.cell) / layer.width;
+            Rectangle destination{
+                (float) x * tilemap.scale * range.tile_width,
+                (float) y * tilemap.scale * range.tile_height,
+                range.tile_width * tilemap.scale,
+                range.tile_height * tilemap.scale
+            };
+            e.world().entity().child_of(layer_entities[property_tile.layer])
+                    .set<TilemapLayerTile>({
+                        tileset_entities[tileset],
+                        tiles::source(range, gid),
+                        destination,
+                        tiles::rotation(gid),
                     });
-                }
-            }
+        }
 
-            for (auto col: merged_colliders) {
-                e.world().entity()
-                        .set<core::Position2D>({col.x, col.y})
-                        .set<physics::Collider>({
-                            false,
-                            true,
-                            {0, 0, col.width, col.height},
-                            physics::environment, physics::environment_filter,
-                            physics::ColliderType::Box
-                        })
-                        .add<physics::BoxCollider>()
-                        .add<physics::StaticCollider>();
-            }
+        chunks.layers = std::move(data.layers);
+        e.set<TilemapChunks>(chunks);
+
+        // kept per tile for pathing
+        physics::CollisionGrid grid{
+            data.width, data.height, data.tile_width * tilemap.scale, {0, 0}, std::move(data.blocked)
+        };
+        e.world().set<physics::CollisionGrid>(grid);
+
+        // the colliders come merged, in tiles, centered on the tile grid like the chunks
+        const float tile_width = data.tile_width * tilemap.scale;
+        const float tile_height = data.tile_height * tilemap.scale;
+        for (const Rectangle &col: data.colliders) {
+            e.world().entity()
+                    .set<core::Position2D>({
+                        col.x * tile_width - tile_width / 2.0f, col.y * tile_height - tile_height / 2.0f
+                    })
+                    .set<physics::Collider>({
+                        false,
+                        true,
+                        {0, 0, col.width * tile_width, col.height * tile_height},
+                        physics::environment, physics::environment_filter,
+                        physics::ColliderType::Box
+                    })
+                    .add<physics::BoxCollider>()
+                    .add<physics::StaticCollider>();
         }
     }
 }
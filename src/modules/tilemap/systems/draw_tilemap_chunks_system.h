@@ -0,0 +1,63 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef DRAW_TILEMAP_CHUNKS_SYSTEM_H
+#define DRAW_TILEMAP_CHUNKS_SYSTEM_H
+
+#include <vector>
+
+#include <flecs.h>
+#include <raylib.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/tilemap/chunks.h"
+#include "modules/tilemap/components.h"
+
+namespace tilemap::systems {
+    // bakes the chunks entering the view, at most BAKES_PER_FRAME of them, draws the resident ones layer by layer
+    // and unloads the least recently drawn once over the budget
+    inline void draw_tilemap_chunks_system(TilemapChunks &chunks, const rendering::TrackingCamera &camera,
+                                           const core::GameSettings &settings) {
+        chunks.frame++;
+        const Camera2D &view = camera.camera;
+        const float zoom = view.zoom > 0.0f ? view.zoom : 1.0f;
+        Rectangle area{
+            view.target.x - view.offset.x / zoom,
+            view.target.y - view.offset.y / zoom,
+            settings.window_width / zoom,
+            settings.window_height / zoom
+        };
+        const chunks::Range range = chunks::visible(chunks, area);
+
+        int bakes = 0;
+        for (int layer = 0; layer < static_cast<int>(chunks.layers.size()); layer++) {
+            for (int y = range.min_y; y <= range.max_y; y++) {
+                for (int x = range.min_x; x <= range.max_x; x++) {
+                    auto found = chunks.resident.find(chunks::key(layer, x, y));
+                    if (found == chunks.resident.end()) {
+                        if (bakes >= chunks::BAKES_PER_FRAME) continue;
+                        bakes++;
+                        Image image = chunks::bake(chunks, layer, x, y);
+                        TilemapChunk chunk{
+                            LoadTextureFromImage(image), static_cast<size_t>(image.width) * image.height * 4, 0
+                        };
+                        UnloadImage(image);
+                        chunks.bytes += chunk.bytes;
+                        found = chunks.resident.emplace(chunks::key(layer, x, y), chunk).first;
+                    }
+                    found->second.last_used = chunks.frame;
+                    Rectangle bounds = chunks::bounds(chunks, x, y);
+                    DrawTexture(found->second.texture, static_cast<int>(bounds.x), static_cast<int>(bounds.y), WHITE);
+                }
+            }
+        }
+
+        std::vector<Texture2D> released;
+        chunks::trim(chunks, released);
+        for (const Texture2D &texture: released)
+            UnloadTexture(texture);
+    }
+}
+#endif //DRAW_TILEMAP_CHUNKS_SYSTEM_H
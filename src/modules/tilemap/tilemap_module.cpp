@@ -5,9 +5,12 @@
 #include "tilemap_module.h"
 
 #include "components.h"
+#include "modules/engine/core/components.h"
+#include "modules/engine/rendering/components.h"
 #include "modules/engine/rendering/pipeline_steps.h"
 #include "modules/engine/rendering/rendering_module.h"
 #include "systems/create_tilemap_system.h"
+#include "systems/draw_tilemap_chunks_system.h"
 
 
 namespace tilemap {
@@ -15,9 +18,14 @@ namespace tilemap {
     }
 
     void TilemapModule::register_systems(flecs::world world) {
-        world.system<const Tilemap>("create tilemaps")
-                .kind(flecs::OnStart)
+        world.system<const Tilemap, assets::AssetStore>("create tilemaps")
+                .kind(flecs::OnLoad)
+                .without<TilemapChunks>()
                 .each(systems::create_tilemap_system);
 
+        world.system<TilemapChunks, const rendering::TrackingCamera, const core::GameSettings>("draw tilemap chunks")
+                .kind<rendering::RenderBackground>()
+                .each(systems::draw_tilemap_chunks_system);
+
     }
 }
@@ -0,0 +1,40 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "tiles.h"
+
+#include <algorithm>
+
+namespace tilemap::tiles {
+    int find(const std::vector<TilesetRange> &ranges, uint32_t gid) {
+        const uint32_t id = gid & ID_MASK;
+        if (id == 0) return -1;
+
+        // first range starting after the id, the owner is the one before it
+        auto after = std::upper_bound(ranges.begin(), ranges.end(), id,
+                                      [](uint32_t value, const TilesetRange &range) { return value < range.first_gid; });
+        if (after == ranges.begin()) return -1;
+        auto owner = after - 1;
+        if (id > owner->last_gid) return -1;
+        return static_cast<int>(owner - ranges.begin());
+    }
+
+    Rectangle source(const TilesetRange &range, uint32_t gid) {
+        const int local = static_cast<int>((gid & ID_MASK) - range.first_gid);
+        const int columns = std::max(range.columns, 1);
+        float width = range.tile_width;
+        float height = range.tile_height;
+        if (gid & FLIPPED_DIAGONALLY) height = -height;
+        if (gid & FLIPPED_HORIZONTALLY) width = -width;
+        if (gid & FLIPPED_VERTICALLY) height = -height;
+        return {
+                static_cast<float>(range.margin) + (local % columns) * (range.tile_width + range.spacing),
+                static_cast<float>(range.margin) + (local / columns) * (range.tile_height + range.spacing),
+                width,
+                height,
+        };
+    }
+
+    float rotation(uint32_t gid) { return gid & FLIPPED_DIAGONALLY ? -90.0f : 0.0f; }
+}
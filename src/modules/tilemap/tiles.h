@@ -0,0 +1,36 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef TILEMAP_TILES_H
+#define TILEMAP_TILES_H
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+#include "components.h"
+
+namespace tilemap::tiles {
+    // Tiled keeps the flips in the top bits of the gid, tmxlite's FlipFlag values shifted by 28
+    constexpr uint32_t FLIPPED_HORIZONTALLY = 0x80000000;
+    constexpr uint32_t FLIPPED_VERTICALLY = 0x40000000;
+    constexpr uint32_t FLIPPED_DIAGONALLY = 0x20000000;
+    constexpr uint32_t ID_MASK = 0x1FFFFFFF;
+
+    inline uint32_t gid(uint32_t id, uint8_t flip_flags) {
+        return id == 0 ? 0 : (id & ID_MASK) | static_cast<uint32_t>(flip_flags) << 28;
+    }
+
+    // binary search of the tileset owning the gid in ranges sorted by first gid, -1 for empty or unknown tiles
+    int find(const std::vector<TilesetRange> &ranges, uint32_t gid);
+
+    // rectangle of the tile in the tileset image, flipped tiles get a negative size like DrawTexturePro takes
+    Rectangle source(const TilesetRange &range, uint32_t gid);
+
+    // diagonal flips are drawn as a quarter turn counter clockwise of the vertically flipped tile
+    float rotation(uint32_t gid);
+}
+
+#endif //TILEMAP_TILES_H
@@ -42,14 +42,18 @@ void PerfRecorder::start_live_recording() {
 }
 void PerfRecorder::save_frame(flecs::world world, int fps) {
     double update, detection, resolution, event, cleanup, total;
-    update = physics::get_update_time();
-    detection = physics::get_detection_time();
-    resolution = physics::get_resolution_time();
-    event = physics::get_event_time();
-    cleanup = physics::get_cleanup_time();
+    update = physics::get_update_time(world);
+    detection = physics::get_detection_time(world);
+    resolution = physics::get_resolution_time(world);
+    event = physics::get_event_time(world);
+    cleanup = physics::get_cleanup_time(world);
     total = update + detection + resolution + event + cleanup;
 
 
+    const core::DestructionStats &destruction = world.get<core::DestructionStats>();
+    const physics::CrowdSeparation &crowd = world.get<physics::CrowdSeparation>();
+    double contacts_per_body = crowd.bodies > 0 ? static_cast<double>(crowd.contacts) / crowd.bodies : 0.0;
+
     double a = m_live_event_counter->get("L1-dcache-loads");
     double b = m_live_event_counter->get("L1-dcache-load-misses");
     auto map = std::vector<std::string>{std::to_string(m_counters.size()),
@@ -59,10 +63,26 @@ void PerfRecorder::save_frame(flecs::world world, int fps) {
                                         std::to_string(total),
                                         std::to_string(a),
                                         std::to_string(b),
-                                        std::to_string(b / a)};
+                                        std::to_string(b / a),
+                                        // new columns go last, experiment.py reads the leading ones by position
+                                        std::to_string(destruction.destroyed),
+                                        std::to_string(destruction.milliseconds),
+                                        std::to_string(contacts_per_body)};
 
     m_counters.push_back(map);
 }
+void PerfRecorder::save_simulation_tick(double seconds, double physics_seconds) {
+    m_simulation_ticks.emplace_back(seconds, physics_seconds);
+}
+void PerfRecorder::save_spatial_hash_stats(flecs::world world) {
+    const physics::SpatialHashStats &stats = world.get<physics::SpatialHashStats>();
+    if (!stats.recording || stats.tick == m_last_cell_tick) return;
+    m_last_cell_tick = stats.tick;
+    for (const auto &[cell, cell_stats]: stats.cells) {
+        m_cells.push_back({stats.tick, cell.first, cell.second, cell_stats.occupancy, cell_stats.candidate_pairs,
+                           cell_stats.hits, stats.detection_seconds});
+    }
+}
 void PerfRecorder::stop_live_recording() {
     m_live_event_counter->stop();
     auto now = std::chrono::high_resolution_clock::now();
@@ -76,8 +96,10 @@ void PerfRecorder::dump_data(std::string file_dir, std::string file_name) {
     try {
         if (std::ofstream file(file_dir + file_name); file.is_open()) {
             file << "frame" << "," << "nb of entities" << "," << "FPS" << "," << "frame length" << ","
-                 << "physics length" << "," << "L1-dcache-loads" << ","
-                 << "L1-dcache-load-misses" << "," << "L1-dcache-load-miss-ratio" << "\n";
+                 << "physics length" << ","
+                 << "L1-dcache-loads" << ","
+                 << "L1-dcache-load-misses" << "," << "L1-dcache-load-miss-ratio" << ","
+                 << "destroyed" << "," << "destruction length" << "," << "contacts per body" << "\n";
             for (int i = 0; i < m_counters.size(); i++) {
                 for (int j = 0; j < m_counters[i].size(); j++) {
                     file << m_counters[i][j];
@@ -95,3 +117,37 @@ void PerfRecorder::dump_data(std::string file_dir, std::string file_name) {
         std::cout << "could not write results" << e.what() << std::endl;
     }
 }
+void PerfRecorder::dump_simulation_data(std::string file_dir, std::string file_name) {
+    if (m_simulation_ticks.empty()) return;
+    try {
+        if (std::ofstream file(file_dir + file_name); file.is_open()) {
+            file << "tick" << "," << "tick length" << "," << "physics length" << "\n";
+            for (int i = 0; i < m_simulation_ticks.size(); i++) {
+                file << i << "," << m_simulation_ticks[i].first << "," << m_simulation_ticks[i].second << "\n";
+            }
+            file.close();
+        } else {
+            printf("Failed to open file %s\n", std::string(file_dir + file_name).c_str());
+        }
+    } catch (std::exception &e) {
+        std::cout << "could not write results" << e.what() << std::endl;
+    }
+}
+void PerfRecorder::dump_spatial_hash_data(std::string file_dir, std::string file_name) {
+    if (m_cells.empty()) return;
+    try {
+        if (std::ofstream file(file_dir + file_name); file.is_open()) {
+            file << "tick" << "," << "cell x" << "," << "cell y" << "," << "occupancy" << "," << "candidate pairs"
+                 << "," << "hits" << "," << "detection length" << "\n";
+            for (const CellRow &row: m_cells) {
+                file << row.tick << "," << row.x << "," << row.y << "," << row.occupancy << ","
+                     << row.candidate_pairs << "," << row.hits << "," << row.detection_seconds << "\n";
+            }
+            file.close();
+        } else {
+            printf("Failed to open file %s\n", std::string(file_dir + file_name).c_str());
+        }
+    } catch (std::exception &e) {
+        std::cout << "could not write results" << e.what() << std::endl;
+    }
+}
@@ -32,13 +32,32 @@ public:
     void stop_live_recording();
 
     void save_frame(flecs::world, int);
+    // wall time of one step of the simulation thread, the counters only follow the thread that started them
+    void save_simulation_tick(double seconds, double physics_seconds);
+    // the spatial hash cells of the last detection tick, once per tick and only while they are recorded
+    void save_spatial_hash_stats(flecs::world);
     [[nodiscard]] float get_dt() const {return dt;}
 
     void dump_data(std::string file_dir, std::string file_name);
+    void dump_simulation_data(std::string file_dir, std::string file_name);
+    void dump_spatial_hash_data(std::string file_dir, std::string file_name);
 private:
 
 
     std::vector<std::vector<std::string>> m_counters;
+    // tick length and physics length, only filled by the threaded loop
+    std::vector<std::pair<double, double>> m_simulation_ticks;
+    struct CellRow {
+        uint32_t tick;
+        long x;
+        long y;
+        int occupancy;
+        int candidate_pairs;
+        int hits;
+        double detection_seconds;
+    };
+    std::vector<CellRow> m_cells;
+    uint32_t m_last_cell_tick = 0;
 
     std::unique_ptr<perf::EventCounter> m_event_counter;
     std::unique_ptr<perf::LiveEventCounter> m_live_event_counter;
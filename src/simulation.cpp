@@ -0,0 +1,307 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "simulation.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "modules/ai/ai_module.h"
+#include "modules/ai/components.h"
+#include "modules/debug/debug_module.h"
+#include "modules/engine/assets/assets_module.h"
+#include "modules/engine/core/components.h"
+#include "modules/engine/core/core_module.h"
+#include "modules/engine/core/tags.h"
+#include "modules/engine/input/components.h"
+#include "modules/engine/input/input_module.h"
+#include "modules/engine/physics/physics_module.h"
+#include "modules/engine/rendering/atlas.h"
+#include "modules/engine/rendering/components.h"
+#include "modules/engine/rendering/pipeline_steps.h"
+#include "modules/engine/rendering/rendering_module.h"
+#include "modules/gameplay/components.h"
+#include "modules/gameplay/gameplay_module.h"
+#include "modules/gameplay/wave_spawner.h"
+#include "modules/player/player_module.h"
+#include "modules/tilemap/tilemap_module.h"
+
+namespace simulation {
+    std::vector<flecs::entity> import_modules(flecs::world &world, bool headless) {
+        std::vector<flecs::entity> modules;
+        modules.push_back(world.import <core::CoreModule>());
+        modules.push_back(world.import <input::InputModule>());
+        // before rendering, the gui requests its fonts and textures while registering
+        if (!headless) modules.push_back(world.import <assets::AssetsModule>());
+        if (!headless) modules.push_back(world.import <rendering::RenderingModule>());
+        modules.push_back(world.import <physics::PhysicsModule>());
+        modules.push_back(world.import <player::PlayerModule>());
+        modules.push_back(world.import <ai::AIModule>());
+        modules.push_back(world.import <gameplay::GameplayModule>());
+        if (!headless) modules.push_back(world.import <debug::DebugModule>());
+        if (!headless) modules.push_back(world.import <tilemap::TilemapModule>());
+        return modules;
+    }
+
+    void create_entities(flecs::world &world, const std::string &name, int width, int height, uint32_t seed,
+                         bool headless) {
+        world.set<core::GameSettings>({name, width, height, width, height});
+        world.add<physics::CollisionRecordList>();
+        world.set<physics::SpatialHashingGrid>({32, {0, 0}});
+        world.set<core::Paused>({false});
+        world.set<core::EnabledMenus>({0});
+        world.set<core::Random>({std::mt19937(seed)});
+
+        flecs::entity player = world.entity("player")
+                                       .set<core::Tag>({"player"})
+                                       .add<ai::FlowFieldGoal>()
+                                       .set<core::Position2D>({2300.0f, 1300.0f})
+                                       .set<core::Speed>({300})
+                                       .set<physics::Velocity2D>({0, 0})
+                                       .set<physics::DesiredVelocity2D>({0, 0})
+                                       .set<physics::AccelerationSpeed>({15.0})
+                                       .set<physics::Collider>({
+                                               false,
+                                               true,
+                                               {-16, -16, 32, 32},
+                                               physics::CollisionFilter::player,
+                                               physics::player_filter,
+                                               physics::ColliderType::Circle,
+                                       })
+                                       .set<physics::CircleCollider>({16})
+                                       .set<rendering::Priority>({2})
+                                       .set<gameplay::Experience>({1, 0, 100000});
+
+
+        auto hori = world.entity("player_horizontal_input").child_of(player).set<input::InputHorizontal>({});
+        world.entity().child_of(hori).set<input::KeyBinding>({KEY_A, -1});
+        world.entity().child_of(hori).set<input::KeyBinding>({KEY_D, 1});
+        world.entity().child_of(hori).set<input::KeyBinding>({KEY_LEFT, -1});
+        world.entity().child_of(hori).set<input::KeyBinding>({KEY_RIGHT, 1});
+
+        auto vert = world.entity("player_vertical_input").child_of(player).set<input::InputVertical>({});
+        world.entity().child_of(vert).set<input::KeyBinding>({KEY_W, -1});
+        world.entity().child_of(vert).set<input::KeyBinding>({KEY_S, 1});
+        world.entity().child_of(vert).set<input::KeyBinding>({KEY_UP, -1});
+        world.entity().child_of(vert).set<input::KeyBinding>({KEY_DOWN, 1});
+
+        flecs::entity enemy = world.prefab("enemy")
+                                      .set<core::Tag>({"enemy"})
+                                      .set<core::Position2D>({800, 400})
+                                      .set<core::Speed>({25})
+                                      .set<gameplay::Health>({10, 10})
+                                      .set<gameplay::Damage>({1})
+                                      .set<gameplay::GiveExperience, gameplay::OnDeathEffect>({player, 2})
+                                      .add<ai::Target>(player)
+                                      .add<ai::FollowTarget>()
+                                      .set<ai::StoppingDistance>({16.0})
+                                      .set<physics::Velocity2D>({0, 0})
+                                      .set<physics::DesiredVelocity2D>({0, 0})
+                                      .set<physics::AccelerationSpeed>({5.0})
+                                      .set<physics::Collider>({true,
+                                                               false,
+                                                               {-16, -16, 32, 32},
+                                                               physics::CollisionFilter::enemy,
+                                                               physics::enemy_filter,
+                                                               physics::ColliderType::Circle})
+                                      .set<physics::CircleCollider>({16})
+                                      .set<physics::Separation>({40.0f})
+                                      .set<rendering::Priority>({0});
+
+        world.entity("enemy_spawner").set<gameplay::Spawner>({enemy, 1, false});
+
+        if (headless) {
+            // nothing culls without the rendering module, the camera stays centered on the player spawn
+            player.add<rendering::Visible>();
+            enemy.add<rendering::Visible>();
+            Camera2D camera{{width / 2.0f, height / 2.0f}, player.get<core::Position2D>().value, 0.0f, 1.0f};
+            world.set<rendering::TrackingCamera>({player, camera});
+            return;
+        }
+
+        // one texture for every sprite, baked by the atlas_baker tool or packed here when it hasn't run
+        world.set<rendering::Atlas>(
+                rendering::atlas::load(world.get_mut<assets::AssetStore>(), "../resources", "atlas"));
+        const rendering::Atlas &atlas = world.get<rendering::Atlas>();
+        player.set<rendering::Renderable>({rendering::atlas::sprite(atlas, "player"), // 8x8
+                                           {0, 0},
+                                           2.f,
+                                           WHITE});
+        enemy.set<rendering::Renderable>({rendering::atlas::sprite(atlas, "ghost"), // 8x8
+                                          {0, 0},
+                                          2.f,
+                                          WHITE});
+        world.set<rendering::TrackingCamera>({player, Camera2D{0}});
+    }
+
+    flecs::entity simulation_pipeline(flecs::world &world) {
+        return world.pipeline()
+                .with(flecs::System)
+                .with(flecs::Phase).cascade(flecs::DependsOn)
+                .without(flecs::DependsOn, flecs::OnStart)
+                .without(flecs::Disabled).up(flecs::DependsOn)
+                .without(flecs::Disabled).up(flecs::ChildOf)
+                .without<core::MainThread>().self().up(flecs::DependsOn)
+                .build();
+    }
+
+    flecs::entity main_thread_pipeline(flecs::world &world) {
+        return world.pipeline()
+                .with(flecs::System)
+                .with(flecs::Phase).cascade(flecs::DependsOn)
+                .without(flecs::DependsOn, flecs::OnStart)
+                .without(flecs::Disabled).up(flecs::DependsOn)
+                .without(flecs::Disabled).up(flecs::ChildOf)
+                .with<core::MainThread>().self().up(flecs::DependsOn)
+                .without<core::OutsideWorldLock>()
+                .without<rendering::Overlay>().self().up(flecs::DependsOn)
+                .build();
+    }
+
+    flecs::entity overlay_pipeline(flecs::world &world) {
+        return world.pipeline()
+                .with(flecs::System)
+                .with(flecs::Phase).cascade(flecs::DependsOn)
+                .without(flecs::DependsOn, flecs::OnStart)
+                .without(flecs::Disabled).up(flecs::DependsOn)
+                .without(flecs::Disabled).up(flecs::ChildOf)
+                .with<rendering::Overlay>().self().up(flecs::DependsOn)
+                .without<core::OutsideWorldLock>()
+                .build();
+    }
+
+    void spawn_enemies_in_view(flecs::world &world, int count) {
+        if (count <= 0) return;
+
+        flecs::entity enemy = world.lookup("enemy");
+        flecs::entity spawner = world.lookup("enemy_spawner");
+        const core::GameSettings &settings = world.get<core::GameSettings>();
+        const Camera2D &camera = world.get<rendering::TrackingCamera>().camera;
+        std::mt19937 &rng = world.get_mut<core::Random>().engine;
+
+        std::uniform_real_distribution<float> x(camera.target.x - settings.window_width / 2.0f,
+                                                camera.target.x + settings.window_width / 2.0f);
+        std::uniform_real_distribution<float> y(camera.target.y - settings.window_height / 2.0f,
+                                                camera.target.y + settings.window_height / 2.0f);
+        std::vector<core::Position2D> positions;
+        positions.reserve(count);
+        for (int i = 0; i < count; i++) {
+            positions.push_back({{x(rng), y(rng)}});
+        }
+        gameplay::waves::bulk_spawn(world, enemy, spawner, positions);
+    }
+
+    std::vector<benchmark::LevelResult> run_sweep(flecs::world &world, const std::string &name,
+                                                  const benchmark::BenchmarkConfig &config,
+                                                  const std::function<void()> &step,
+                                                  const std::function<bool()> &should_stop) {
+        std::vector<benchmark::LevelResult> results;
+
+        // ON START
+        world.progress();
+
+        // the sweep controls the population itself, the regular spawner would keep adding entities mid-level
+        gameplay::SpawnerSystem spawners = world.get<gameplay::SpawnerSystem>();
+        spawners.system.disable();
+        spawners.wave_system.disable();
+        world.get_mut<physics::CrowdSeparation>().enabled = config.separation;
+        // only the enemies make up the population, the player and the static tilemap colliders stay out of it
+        auto enemies = world.query_builder<const core::Position2D, const physics::Collider>()
+                               .with<core::TaggedAs>(core::tags::intern(world, "enemy"))
+                               .without<core::DestroyAfterFrame>()
+                               .build();
+
+        for (int entity_count: config.entity_counts) {
+            if (should_stop()) break;
+
+            spawn_enemies_in_view(world, entity_count - enemies.count());
+
+            for (int tick = 0; tick < config.warmup_ticks; tick++) {
+                step();
+            }
+
+            std::vector<double> physics_times;
+            std::vector<double> frame_times;
+            long contacts = 0;
+            long bodies = 0;
+            physics_times.reserve(config.measured_ticks);
+            frame_times.reserve(config.measured_ticks);
+            for (int tick = 0; tick < config.measured_ticks; tick++) {
+                // enemies merged into swarms or killed during the level are replaced outside the measured step
+                spawn_enemies_in_view(world, entity_count - enemies.count());
+                auto start = std::chrono::high_resolution_clock::now();
+                step();
+                auto end = std::chrono::high_resolution_clock::now();
+                frame_times.push_back(std::chrono::duration<double>(end - start).count());
+                physics_times.push_back(physics::get_total_time(world));
+                const auto &crowd = world.get<physics::CrowdSeparation>();
+                contacts += crowd.contacts;
+                bodies += crowd.bodies;
+            }
+
+            uint32_t seed = config.seed + entity_count;
+            benchmark::LevelResult result{
+                    name, entity_count,
+                    benchmark::summarize(physics_times, config.bootstrap_resamples, config.confidence, seed),
+                    benchmark::summarize(frame_times, config.bootstrap_resamples, config.confidence, seed),
+                    bodies > 0 ? static_cast<double>(contacts) / bodies : 0.0};
+            results.push_back(result);
+
+            if (result.frame.median > config.max_frame_time) break;
+        }
+        return results;
+    }
+
+    std::vector<benchmark::LevelResult> run_headless(const std::vector<HeadlessRun> &runs,
+                                                     const benchmark::BenchmarkConfig &config, int width,
+                                                     int height, int threads) {
+        // component ids are assigned process wide on first registration, do it once here before the workers race
+        {
+            flecs::world world;
+            auto modules = import_modules(world, true);
+            create_entities(world, "warmup", width, height, 0, true);
+            for (auto module: modules) {
+                module.destruct();
+            }
+        }
+
+        std::vector<std::vector<benchmark::LevelResult>> run_results(runs.size());
+        std::atomic<size_t> next_run = 0;
+        auto worker = [&]() {
+            for (size_t i = next_run++; i < runs.size(); i = next_run++) {
+                const HeadlessRun &run = runs[i];
+                flecs::world world;
+                auto modules = import_modules(world, true);
+                create_entities(world, run.name, width, height, run.seed, true);
+                physics::PhysicsModule::set_collision_strategy(world, run.strategy);
+
+                run_results[i] = run_sweep(
+                        world, run.name, config, [&world]() { world.progress(physics::PHYSICS_TICK_LENGTH); },
+                        []() { return false; });
+
+                world.quit();
+                world.progress();
+                for (auto module: modules) {
+                    module.destruct();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < std::max(1, threads); t++) {
+            workers.emplace_back(worker);
+        }
+        for (std::thread &t: workers) {
+            t.join();
+        }
+
+        std::vector<benchmark::LevelResult> results;
+        for (auto &r: run_results) {
+            results.insert(results.end(), r.begin(), r.end());
+        }
+        return results;
+    }
+}
@@ -0,0 +1,74 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "benchmark/strategy_benchmark.h"
+#include "flecs.h"
+#include "modules/engine/physics/components.h"
+
+namespace simulation {
+    /**
+     * Import the game modules into a world. Headless worlds have no window or GL context, so the rendering,
+     * debug and tilemap modules are left out.
+     * @return the module entities, destruct them before resetting the world
+     */
+    std::vector<flecs::entity> import_modules(flecs::world &world, bool headless);
+
+    /**
+     * Create the singletons, the player, the enemy prefab and its spawner. Headless entities get no sprite and
+     * are marked visible directly since there is no camera culling to do it.
+     */
+    void create_entities(flecs::world &world, const std::string &name, int width, int height, uint32_t seed,
+                         bool headless);
+
+    /**
+     * Every phased system but the core::MainThread ones, tagged themselves or through their phase. Run it with
+     * run_pipeline from the simulation thread, startup systems are left to the first progress.
+     */
+    flecs::entity simulation_pipeline(flecs::world &world);
+
+    /**
+     * The core::MainThread systems up to the snapshot draw, input, uploads, gui preparation and the camera, in the
+     * same phase order as the default pipeline. Leaves out the core::OutsideWorldLock and rendering::Overlay ones.
+     */
+    flecs::entity main_thread_pipeline(flecs::world &world);
+
+    // the rendering::Overlay systems, gizmos and gui drawn over the snapshot once the main thread has drawn it
+    flecs::entity overlay_pipeline(flecs::world &world);
+
+    // bring the population up by `count` enemies spread uniformly over the screen around the camera
+    void spawn_enemies_in_view(flecs::world &world, int count);
+
+    /**
+     * Climb the entity counts of the config on an initialized world, measuring each level over the configured
+     * ticks. `step` advances the world by one frame, the sweep ends early when `should_stop` returns true or a
+     * frame gets slower than the config allows.
+     */
+    std::vector<benchmark::LevelResult> run_sweep(flecs::world &world, const std::string &name,
+                                                  const benchmark::BenchmarkConfig &config,
+                                                  const std::function<void()> &step,
+                                                  const std::function<bool()> &should_stop);
+
+    struct HeadlessRun {
+        std::string name;
+        physics::PHYSICS_COLLISION_STRATEGY strategy;
+        uint32_t seed;
+    };
+
+    /**
+     * Run every sweep in its own headless world, `threads` worlds at a time. Worlds share nothing, results come
+     * back in the order of the runs.
+     */
+    std::vector<benchmark::LevelResult> run_headless(const std::vector<HeadlessRun> &runs,
+                                                     const benchmark::BenchmarkConfig &config, int width,
+                                                     int height, int threads);
+}
+
+#endif //SIMULATION_H
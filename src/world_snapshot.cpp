@@ -0,0 +1,406 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include "world_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <raylib.h>
+
+#include "modules/engine/core/components.h"
+#include "modules/engine/physics/components.h"
+#include "modules/gameplay/components.h"
+
+namespace snapshot {
+    static constexpr char snapshot_magic[4] = {'E', 'C', 'S', 'W'};
+    // bump when a stored component changes layout, the columns are raw copies of the structs
+    static constexpr uint32_t snapshot_version = 2;
+    static constexpr uint32_t no_parent = UINT32_MAX;
+    static constexpr uint32_t no_target = UINT32_MAX;
+
+    enum ColumnMask : uint8_t {
+        velocity = 1 << 0,
+        desired_velocity = 1 << 1,
+        collider = 1 << 2,
+        health = 1 << 3,
+    };
+
+    // a tag (second is no_target) or a pair without data, both ends stored by path
+    using IdKey = std::pair<uint32_t, uint32_t>;
+
+    // a pair whose target is an instance, it has no path and is only known by its index among the saved entities
+    struct Relationship {
+        flecs::entity source;
+        uint32_t relationship;
+        flecs::entity target;
+    };
+
+    template<typename T>
+    static void write_value(std::ofstream &file, const T &value) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static T read_value(std::ifstream &file) {
+        T value{};
+        file.read(reinterpret_cast<char *>(&value), sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static void write_column(std::ofstream &file, const std::vector<flecs::entity> &entities) {
+        std::vector<T> column;
+        column.reserve(entities.size());
+        for (flecs::entity e: entities) {
+            column.push_back(e.get<T>());
+        }
+        file.write(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+    }
+
+    // whether `count` elements of T are left, checked before sizing anything from a count read off the file
+    template<typename T>
+    static bool fits(std::ifstream &file, std::streamoff file_size, uint64_t count) {
+        if (!file) return false;
+        std::streamoff left = file_size - file.tellg();
+        return left >= 0 && count <= static_cast<uint64_t>(left) / sizeof(T);
+    }
+
+    template<typename T>
+    static bool read_column(std::ifstream &file, std::streamoff file_size, uint32_t count, std::vector<T> &column) {
+        if (!fits<T>(file, file_size, count)) return false;
+        column.resize(count);
+        file.read(reinterpret_cast<char *>(column.data()), count * sizeof(T));
+        return static_cast<bool>(file);
+    }
+
+    static uint8_t column_mask(flecs::entity e) {
+        uint8_t mask = 0;
+        if (e.has<physics::Velocity2D>()) mask |= velocity;
+        if (e.has<physics::DesiredVelocity2D>()) mask |= desired_velocity;
+        if (e.has<physics::Collider>()) mask |= collider;
+        if (e.has<gameplay::Health>()) mask |= health;
+        return mask;
+    }
+
+    // the tags and data-less relationships to keep besides IsA and ChildOf, the components are the columns
+    template<typename Func>
+    static void each_stored_id(flecs::entity e, const Func &func) {
+        e.each([&](flecs::id id) {
+            if (id.type_id()) return;
+            if (!id.is_pair()) {
+                if (id.entity().name()) func(id.entity(), flecs::entity());
+                return;
+            }
+            flecs::entity relationship = id.first();
+            if (relationship == flecs::IsA || relationship == flecs::ChildOf || !relationship.name()) return;
+            func(relationship, id.second());
+        });
+    }
+
+    static void write_ids(std::ofstream &file, const std::vector<IdKey> &ids) {
+        write_value<uint32_t>(file, ids.size());
+        for (const IdKey &id: ids) {
+            write_value(file, id.first);
+            write_value(file, id.second);
+        }
+    }
+
+    // false when the file ends early or an id points past the `path_count` stored paths
+    static bool read_ids(std::ifstream &file, std::streamoff file_size, size_t path_count, std::vector<IdKey> &ids) {
+        if (!read_column(file, file_size, read_value<uint32_t>(file), ids)) return false;
+        return std::all_of(ids.begin(), ids.end(), [&](const IdKey &id) {
+            return id.first < path_count && (id.second == no_target || id.second < path_count);
+        });
+    }
+
+    // 0 when either end is missing from this world, the indices were checked by read_ids
+    static flecs::id_t resolve_id(const std::vector<flecs::entity> &entities, const IdKey &id) {
+        flecs::entity first = entities[id.first];
+        if (!first) return 0;
+        if (id.second == no_target) return first.id();
+        flecs::entity second = entities[id.second];
+        return second ? ecs_pair(first.id(), second.id()) : 0;
+    }
+
+    static void write_columns(std::ofstream &file, uint8_t mask, const std::vector<flecs::entity> &entities) {
+        write_column<core::Position2D>(file, entities);
+        if (mask & velocity) write_column<physics::Velocity2D>(file, entities);
+        if (mask & desired_velocity) write_column<physics::DesiredVelocity2D>(file, entities);
+        if (mask & collider) write_column<physics::Collider>(file, entities);
+        if (mask & health) write_column<gameplay::Health>(file, entities);
+    }
+
+    int save_world(flecs::world world, const std::string &file_path) {
+        std::ofstream file(file_path, std::ios::binary);
+        if (!file.is_open()) {
+            TraceLog(LOG_WARNING, "SNAPSHOT: couldn't open %s", file_path.c_str());
+            return -1;
+        }
+
+        std::vector<std::string> paths;
+        std::map<flecs::entity_t, uint32_t> path_indices;
+        auto path_index = [&](flecs::entity e) {
+            auto [it, inserted] = path_indices.emplace(e.id(), paths.size());
+            if (inserted) paths.emplace_back(e.path().c_str());
+            return it->second;
+        };
+
+        // relationships to named entities are part of the group, they are the same for every instance of it
+        std::vector<Relationship> relationships;
+        auto stored_ids = [&](flecs::entity e) {
+            std::vector<IdKey> ids;
+            each_stored_id(e, [&](flecs::entity first, flecs::entity second) {
+                if (!second)
+                    ids.emplace_back(path_index(first), no_target);
+                else if (second.name())
+                    ids.emplace_back(path_index(first), path_index(second));
+                else
+                    relationships.push_back({e, path_index(first), second});
+            });
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        };
+
+        std::vector<flecs::entity> named;
+        std::vector<std::vector<IdKey>> named_ids;
+        std::map<std::tuple<uint32_t, uint32_t, uint8_t, std::vector<IdKey>>, std::vector<flecs::entity>> groups;
+        world.query_builder<const core::Position2D>()
+                .with(flecs::IsA, flecs::Wildcard).optional()
+                .build()
+                .each([&](flecs::entity e, const core::Position2D &) {
+                    flecs::entity prefab = e.target(flecs::IsA);
+                    if (!prefab) {
+                        if (e.name()) {
+                            named.push_back(e);
+                            named_ids.push_back(stored_ids(e));
+                        }
+                        return;
+                    }
+                    flecs::entity parent = e.parent();
+                    uint32_t parent_index = parent ? path_index(parent) : no_parent;
+                    groups[{path_index(prefab), parent_index, column_mask(e), stored_ids(e)}].push_back(e);
+                });
+
+        // entities are restored in the order they are written, named ones first
+        std::map<flecs::entity_t, uint32_t> saved_indices;
+        for (flecs::entity e: named) saved_indices.emplace(e.id(), saved_indices.size());
+        for (auto &[key, entities]: groups)
+            for (flecs::entity e: entities) saved_indices.emplace(e.id(), saved_indices.size());
+
+        file.write(snapshot_magic, sizeof(snapshot_magic));
+        write_value(file, snapshot_version);
+
+        for (flecs::entity e: named) path_index(e);
+        write_value<uint32_t>(file, paths.size());
+        for (const std::string &path: paths) {
+            write_value<uint32_t>(file, path.size());
+            file.write(path.data(), path.size());
+        }
+
+        int count = 0;
+        write_value<uint32_t>(file, named.size());
+        for (size_t i = 0; i < named.size(); i++) {
+            flecs::entity e = named[i];
+            uint8_t mask = column_mask(e);
+            write_value(file, path_index(e));
+            write_value(file, mask);
+            write_ids(file, named_ids[i]);
+            write_columns(file, mask, {e});
+            count++;
+        }
+
+        write_value<uint32_t>(file, groups.size());
+        for (auto &[key, entities]: groups) {
+            auto &[prefab_index, parent_index, mask, ids] = key;
+            write_value(file, prefab_index);
+            write_value(file, parent_index);
+            write_value(file, mask);
+            write_ids(file, ids);
+            write_value<uint32_t>(file, entities.size());
+            write_columns(file, mask, entities);
+            count += entities.size();
+        }
+
+        // targets that weren't saved (not in the snapshot or without a position) are dropped
+        std::erase_if(relationships, [&](const Relationship &r) { return !saved_indices.contains(r.target.id()); });
+        write_value<uint32_t>(file, relationships.size());
+        for (const Relationship &r: relationships) {
+            write_value(file, saved_indices[r.source.id()]);
+            write_value(file, r.relationship);
+            write_value(file, saved_indices[r.target.id()]);
+        }
+
+        return file.good() ? count : -1;
+    }
+
+    template<typename T>
+    static void add_column(flecs::world world, ecs_bulk_desc_t &desc, std::vector<void *> &data, int &term,
+                           std::vector<T> &column) {
+        desc.ids[term] = world.id<T>();
+        data.push_back(column.data());
+        term++;
+    }
+
+    int load_world(flecs::world world, const std::string &file_path) {
+        std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            TraceLog(LOG_WARNING, "SNAPSHOT: couldn't open %s", file_path.c_str());
+            return -1;
+        }
+        const std::streamoff file_size = file.tellg();
+        file.seekg(0);
+        // what was restored before the damage stays in the world
+        auto corrupt = [&]() {
+            TraceLog(LOG_WARNING, "SNAPSHOT: %s is truncated or corrupt", file_path.c_str());
+            return -1;
+        };
+
+        char magic[4];
+        file.read(magic, sizeof(magic));
+        if (!file || std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0 ||
+            read_value<uint32_t>(file) != snapshot_version) {
+            TraceLog(LOG_WARNING, "SNAPSHOT: %s isn't a world snapshot for this build", file_path.c_str());
+            return -1;
+        }
+
+        // every path is at least its length
+        uint32_t path_count = read_value<uint32_t>(file);
+        if (!fits<uint32_t>(file, file_size, path_count)) return corrupt();
+        std::vector<flecs::entity> entities(path_count);
+        for (flecs::entity &e: entities) {
+            uint32_t length = read_value<uint32_t>(file);
+            if (!fits<char>(file, file_size, length)) return corrupt();
+            std::string path(length, '\0');
+            file.read(path.data(), path.size());
+            e = world.lookup(path.c_str());
+            if (!e) TraceLog(LOG_WARNING, "SNAPSHOT: references a missing entity %s", path.c_str());
+        }
+
+        // indexed like saved_indices when writing, missing entities stay null to keep the indices aligned
+        std::vector<flecs::entity> restored;
+        int count = 0;
+        uint32_t named_count = read_value<uint32_t>(file);
+        for (uint32_t i = 0; i < named_count; i++) {
+            uint32_t index = read_value<uint32_t>(file);
+            uint8_t mask = read_value<uint8_t>(file);
+            std::vector<IdKey> ids;
+            if (index >= entities.size() || !read_ids(file, file_size, entities.size(), ids)) return corrupt();
+            flecs::entity e = entities[index];
+            auto position = read_value<core::Position2D>(file);
+            auto vel = mask & velocity ? read_value<physics::Velocity2D>(file) : physics::Velocity2D{};
+            auto desired = mask & desired_velocity ? read_value<physics::DesiredVelocity2D>(file)
+                                                   : physics::DesiredVelocity2D{};
+            auto col = mask & collider ? read_value<physics::Collider>(file) : physics::Collider{};
+            auto hp = mask & health ? read_value<gameplay::Health>(file) : gameplay::Health{};
+            if (!file) return corrupt();
+            restored.push_back(e);
+            if (!e) continue;
+
+            for (const IdKey &id: ids)
+                if (flecs::id_t resolved = resolve_id(entities, id)) e.add(resolved);
+            e.set<core::Position2D>(position);
+            if (mask & velocity) e.set<physics::Velocity2D>(vel);
+            if (mask & desired_velocity) e.set<physics::DesiredVelocity2D>(desired);
+            if (mask & collider) e.set<physics::Collider>(col);
+            if (mask & health) e.set<gameplay::Health>(hp);
+            count++;
+        }
+
+        uint32_t group_count = read_value<uint32_t>(file);
+        for (uint32_t g = 0; g < group_count; g++) {
+            uint32_t prefab_index = read_value<uint32_t>(file);
+            uint32_t parent_index = read_value<uint32_t>(file);
+            uint8_t mask = read_value<uint8_t>(file);
+            std::vector<IdKey> ids;
+            if (prefab_index >= entities.size() || (parent_index != no_parent && parent_index >= entities.size()) ||
+                !read_ids(file, file_size, entities.size(), ids))
+                return corrupt();
+            flecs::entity prefab = entities[prefab_index];
+            uint32_t size = read_value<uint32_t>(file);
+
+            std::vector<core::Position2D> positions;
+            std::vector<physics::Velocity2D> velocities;
+            std::vector<physics::DesiredVelocity2D> desired;
+            std::vector<physics::Collider> colliders;
+            std::vector<gameplay::Health> healths;
+            if (!read_column(file, file_size, size, positions) ||
+                !read_column(file, file_size, mask & velocity ? size : 0, velocities) ||
+                !read_column(file, file_size, mask & desired_velocity ? size : 0, desired) ||
+                !read_column(file, file_size, mask & collider ? size : 0, colliders) ||
+                !read_column(file, file_size, mask & health ? size : 0, healths))
+                return corrupt();
+            if (!prefab || size == 0) {
+                restored.resize(restored.size() + size);
+                continue;
+            }
+
+            std::vector<flecs::id_t> resolved;
+            for (const IdKey &id: ids)
+                if (flecs::id_t r = resolve_id(entities, id)) resolved.push_back(r);
+
+            // pairs and tags first (no data), the prefab components are copied in by the IsA before the columns are
+            // set. Whatever doesn't fit next to the columns is added once the entities exist
+            const int max_tags = FLECS_ID_DESC_MAX - 7;
+            ecs_bulk_desc_t desc = {};
+            std::vector<void *> data;
+            int term = 0;
+            desc.ids[term++] = ecs_isa(prefab);
+            data.push_back(nullptr);
+            if (parent_index != no_parent && entities[parent_index]) {
+                desc.ids[term++] = ecs_childof(entities[parent_index]);
+                data.push_back(nullptr);
+            }
+            size_t bulk_ids = 0;
+            for (; bulk_ids < resolved.size() && term < max_tags; bulk_ids++) {
+                desc.ids[term++] = resolved[bulk_ids];
+                data.push_back(nullptr);
+            }
+            add_column(world, desc, data, term, positions);
+            if (mask & velocity) add_column(world, desc, data, term, velocities);
+            if (mask & desired_velocity) add_column(world, desc, data, term, desired);
+            if (mask & collider) add_column(world, desc, data, term, colliders);
+            if (mask & health) add_column(world, desc, data, term, healths);
+            desc.count = size;
+            desc.data = data.data();
+
+            const ecs_entity_t *created = ecs_bulk_init(world, &desc);
+
+            // the IsA copies every tag of the prefab, the ones this group had lost are taken off again
+            std::vector<flecs::id_t> lost;
+            each_stored_id(prefab, [&](flecs::entity first, flecs::entity second) {
+                // instance targets went through the relationships, never by path
+                if (second && !second.name()) return;
+                flecs::id_t id = second ? ecs_pair(first.id(), second.id()) : first.id();
+                if (std::find(resolved.begin(), resolved.end(), id) == resolved.end()) lost.push_back(id);
+            });
+            for (uint32_t i = 0; i < size; i++) {
+                flecs::entity e(world, created[i]);
+                for (size_t j = bulk_ids; j < resolved.size(); j++) e.add(resolved[j]);
+                for (flecs::id_t id: lost) e.remove(id);
+                restored.push_back(e);
+            }
+            count += size;
+        }
+
+        uint32_t relationship_count = read_value<uint32_t>(file);
+        for (uint32_t i = 0; i < relationship_count; i++) {
+            uint32_t source = read_value<uint32_t>(file);
+            uint32_t relationship_index = read_value<uint32_t>(file);
+            uint32_t target = read_value<uint32_t>(file);
+            if (!file || relationship_index >= entities.size() || source >= restored.size() ||
+                target >= restored.size())
+                return corrupt();
+            flecs::entity relationship = entities[relationship_index];
+            if (!relationship) continue;
+            if (restored[source] && restored[target]) restored[source].add(relationship, restored[target]);
+        }
+
+        return file ? count : corrupt();
+    }
+}
@@ -0,0 +1,30 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include <string>
+
+#include "flecs.h"
+
+namespace snapshot {
+    /**
+     * Write the simulation state to a binary file. Prefab instances are grouped by (prefab, parent) and stored as
+     * one column per component so they can be bulk created on load, named entities (the player) are stored by path.
+     * Components that only come from the prefab (sprites, speeds) are not written. Tags and relationships without data
+     * are kept by path, relationships to other saved instances by their index in the file.
+     * @return the number of entities written, -1 when the file could not be opened
+     */
+    int save_world(flecs::world world, const std::string &file_path);
+
+    /**
+     * Restore a file written by save_world into a world where the same prefabs and named entities already exist.
+     * Instances are created with ecs_bulk_init, named entities are updated in place.
+     * @return the number of entities restored, -1 when the file is missing or does not match this build
+     */
+    int load_world(flecs::world world, const std::string &file_path);
+}
+
+#endif //WORLD_SNAPSHOT_H
@@ -0,0 +1,46 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include <iostream>
+#include <string>
+
+#include <raylib.h>
+
+#include "modules/engine/rendering/atlas.h"
+
+// atlas_baker <resources directory> [atlas name]
+// packs every png of the directory into <name>.png and writes the sub-rect table next to it as <name>.atlas
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: atlas_baker <resources directory> [atlas name]" << std::endl;
+        return 1;
+    }
+    const std::string directory = argv[1];
+    const std::string name = argc > 2 ? argv[2] : "atlas";
+
+    SetTraceLogLevel(LOG_ERROR);
+    auto files = rendering::atlas::sprite_files(directory, name);
+    if (files.empty()) {
+        std::cerr << "no png in " << directory << std::endl;
+        return 1;
+    }
+
+    rendering::atlas::Layout layout{};
+    Image page = rendering::atlas::bake(files, layout);
+    bool saved = ExportImage(page, (directory + "/" + name + ".png").c_str()) &&
+                 rendering::atlas::save_table(directory + "/" + name + ".atlas", layout);
+    UnloadImage(page);
+    if (!saved) {
+        std::cerr << "couldn't write the atlas to " << directory << std::endl;
+        return 1;
+    }
+
+    std::cout << "packed " << layout.entries.size() << " sprites into " << layout.width << "x" << layout.height
+              << std::endl;
+    for (const auto &entry: layout.entries) {
+        std::cout << "  " << entry.name << " " << entry.rect.x << "," << entry.rect.y << " " << entry.rect.width
+                  << "x" << entry.rect.height << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+//
+// Created by laurent on 19/10/26.
+//
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "modules/tilemap/map_blob.h"
+#include "modules/tilemap/map_data.h"
+
+// map_compiler <maps directory or .tmx files...>
+// parses every map once and writes the .tmb the game loads instead, next to the tmx
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: map_compiler <maps directory or .tmx files...>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> maps;
+    for (int i = 1; i < argc; i++) {
+        std::filesystem::path path = argv[i];
+        if (!std::filesystem::is_directory(path)) {
+            maps.push_back(path);
+            continue;
+        }
+        for (const auto &file: std::filesystem::directory_iterator(path)) {
+            if (file.path().extension() == ".tmx") maps.push_back(file.path());
+        }
+    }
+
+    int failed = 0;
+    for (const auto &map: maps) {
+        tilemap::MapData data{};
+        if (!tilemap::map_data::from_tmx(map.string(), data)) {
+            std::cerr << "couldn't parse " << map << std::endl;
+            failed++;
+            continue;
+        }
+        const std::string output = tilemap::map_blob::path_for(map.string());
+        if (!tilemap::map_blob::write(output, data)) {
+            std::cerr << "couldn't write " << output << std::endl;
+            failed++;
+            continue;
+        }
+        std::cout << map.filename().string() << ": " << data.width << "x" << data.height << ", "
+                  << data.layers.size() << " layers, " << data.colliders.size() << " colliders -> " << output
+                  << std::endl;
+    }
+    return failed == 0 ? 0 : 1;
+}